@@ -89,6 +89,51 @@ int compare_by_freq( const void *n1, const void *n2){
 }
 
 
+// 빈도순 정렬 (counting sort)
+// 정렬된 입력 파일이면 사전은 단어순이므로 빈도별로 순서대로(stable) 나누면 빈도가 같은 단어는 단어순을 유지
+// compare_by_freq로 qsort한 결과와 같고, 시간은 O(단어 수 + 최대 빈도)
+// return	1 if successful
+//			0 if overflow or 사전이 단어순이 아님 (qsort 사용)
+int sort_by_freq( tWordDic *dic){
+	int max_freq = 0;
+	int *start;
+	tWord *sorted;
+
+	if (dic->len <= 0) {
+		return 1;
+	}
+	for (int i = 0; i < dic->len; i++) {
+		if (i > 0 && compare_by_word(&dic->data[i - 1], &dic->data[i]) > 0) {
+			return 0;
+		}
+		if (dic->data[i].freq > max_freq) max_freq = dic->data[i].freq;
+	}
+
+	start = (int *)calloc(max_freq + 2, sizeof(int)); // start[max_freq - f] : 빈도 f인 단어가 들어갈 위치
+	sorted = (tWord *)malloc(dic->len * sizeof(tWord));
+	if (!start || !sorted) {
+		free(start);
+		free(sorted);
+		return 0;
+	}
+
+	for (int i = 0; i < dic->len; i++) {
+		start[max_freq - dic->data[i].freq + 1]++;
+	}
+	for (int k = 1; k <= max_freq + 1; k++) {
+		start[k] += start[k - 1];
+	}
+	for (int i = 0; i < dic->len; i++) {
+		sorted[start[max_freq - dic->data[i].freq]++] = dic->data[i];
+	}
+
+	free(dic->data);
+	dic->data = sorted;
+	dic->capacity = dic->len;
+	free(start);
+	return 1;
+}
+
 
 ////////////////////////////////////////////////////////////////////////////////
 // 함수 정의 (definition)
@@ -145,7 +190,9 @@ int main(int argc, char **argv)
 
 	// 정렬 (빈도 내림차순, 빈도가 같은 경우 단어순)
 	if (option == SORT_BY_FREQ) {
-		qsort( dic->data, dic->len, sizeof(tWord), compare_by_freq);
+		if (!sort_by_freq( dic)) {
+			qsort( dic->data, dic->len, sizeof(tWord), compare_by_freq);
+		}
 	}
 		
 	// 사전을 화면에 출력
@@ -0,0 +1,155 @@
+#include <stdio.h>
+#include <stdlib.h> // malloc, realloc, qsort, atoi
+#include <string.h> // strdup, strcmp
+#include <time.h> // clock_gettime
+
+#include "word_sort.h"
+
+// 단어 배열 정렬 benchmark : qsort vs MSD radix sort (sort_by_word, sort_by_word_parallel)
+// usage: sort_bench FILE [synthetic words]
+// 1. FILE의 모든 단어 (중복 포함)
+// 2. 무작위로 만든 단어 (기본 1000000개, 길이 1-12, 작은 알파벳 26자)
+
+// qsort를 위한 비교 함수
+// 정렬 기준 : 단어
+int compare_by_word( const void *n1, const void *n2){
+	const tWord *word1 = (tWord *)n1;
+	const tWord *word2 = (tWord *)n2;
+
+	return strcmp(word1->word, word2->word);
+}
+
+// 경과 시간 (초)
+static double elapsed( struct timespec *start)
+{
+	struct timespec now;
+	clock_gettime( CLOCK_MONOTONIC, &now);
+	return (now.tv_sec - start->tv_sec) + (now.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+// 정렬 결과가 qsort와 같은지 확인
+static int same_order( tWord *a, tWord *b, int n)
+{
+	for (int i = 0; i < n; i++)
+		if (strcmp( a[i].word, b[i].word) != 0) return 0;
+	return 1;
+}
+
+// 정렬 방법
+#define QSORT		0
+#define RADIX		1
+#define PARALLEL	2
+
+// input을 복사해서 정렬, 시간 (초)
+static double run( int method, int num_thread, tWord *input, tWord *output, int n)
+{
+	struct timespec start;
+	int ret = 1;
+
+	memcpy( output, input, n * sizeof(tWord));
+
+	clock_gettime( CLOCK_MONOTONIC, &start);
+	if (method == QSORT) qsort( output, n, sizeof(tWord), compare_by_word);
+	else if (method == RADIX) ret = sort_by_word( output, n);
+	else ret = sort_by_word_parallel( output, n, num_thread);
+
+	return ret ? elapsed( &start) : -1;
+}
+
+static void bench( const char *name, tWord *input, int n)
+{
+	tWord *expected = (tWord *)malloc( n * sizeof(tWord));
+	tWord *output = (tWord *)malloc( n * sizeof(tWord));
+	double t;
+
+	if (!expected || !output)
+	{
+		fprintf( stderr, "Error: overflow\n");
+		free( expected);
+		free( output);
+		return;
+	}
+
+	printf( "== %s (%d words)\n", name, n);
+
+	t = run( QSORT, 1, input, expected, n);
+	printf( "qsort\t\t%.3f sec\n", t);
+
+	t = run( RADIX, 1, input, output, n);
+	printf( "radix\t\t%.3f sec%s\n", t, same_order( expected, output, n) ? "" : "\tDIFFERENT");
+
+	for (int num_thread = 2; num_thread <= 8; num_thread *= 2)
+	{
+		t = run( PARALLEL, num_thread, input, output, n);
+		printf( "radix %d threads\t%.3f sec%s\n", num_thread, t, same_order( expected, output, n) ? "" : "\tDIFFERENT");
+	}
+
+	free( expected);
+	free( output);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int main( int argc, char **argv)
+{
+	char word[100];
+	tWord *data = NULL;
+	int n = 0, capacity = 0;
+	int num_synthetic = 1000000;
+	unsigned int seed = 12345;
+	FILE *fp;
+
+	if (argc != 2 && argc != 3)
+	{
+		fprintf( stderr, "usage: %s FILE [synthetic words]\n", argv[0]);
+		return 1;
+	}
+	if (argc == 3) num_synthetic = atoi( argv[2]);
+
+	if ((fp = fopen( argv[1], "r")) == NULL)
+	{
+		fprintf( stderr, "cannot open file : %s\n", argv[1]);
+		return 1;
+	}
+	while (fscanf( fp, "%99s", word) != EOF)
+	{
+		if (n == capacity)
+		{
+			capacity = capacity ? capacity * 2 : 1024;
+			data = (tWord *)realloc( data, capacity * sizeof(tWord));
+		}
+		data[n].word = strdup( word);
+		data[n].freq = 1;
+		n++;
+	}
+	fclose( fp);
+
+	bench( argv[1], data, n);
+
+	for (int i = 0; i < n; i++) free( data[i].word);
+	free( data);
+
+	// synthetic corpus
+	data = (tWord *)malloc( num_synthetic * sizeof(tWord));
+	if (!data) return 100;
+	for (int i = 0; i < num_synthetic; i++)
+	{
+		int len;
+		seed = seed * 1103515245 + 12345;
+		len = 1 + (seed >> 16) % 12;
+		for (int k = 0; k < len; k++)
+		{
+			seed = seed * 1103515245 + 12345;
+			word[k] = 'a' + (seed >> 16) % 26;
+		}
+		word[len] = '\0';
+		data[i].word = strdup( word);
+		data[i].freq = 1;
+	}
+
+	bench( "synthetic", data, num_synthetic);
+
+	for (int i = 0; i < num_synthetic; i++) free( data[i].word);
+	free( data);
+
+	return 0;
+}
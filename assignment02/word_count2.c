@@ -2,6 +2,8 @@
 #include <stdlib.h> // malloc, realloc, free, qsort
 #include <string.h> // strdup, strcmp, memmove
 
+#include "outbuf.h"
+
 #define SORT_BY_WORD	0 // 단어 순 정렬
 #define SORT_BY_FREQ	1 // 빈도 순 정렬
 
@@ -59,10 +61,15 @@ void word_count( FILE *fp, tWordDic *dic){
 
 
 // 사전을 화면에 출력 ("단어\t빈도" 형식)
+// outbuf로 모아서 출력
 void print_dic( tWordDic *dic){
 	for (int i = 0; i < dic->len; i++) {
-		printf("%s\t%d\n", dic->data[i].word, dic->data[i].freq);
+		out_str(dic->data[i].word);
+		out_char('\t');
+		out_int(dic->data[i].freq);
+		out_char('\n');
 	}
+	out_flush();
 }
 
 // 사전에 할당된 메모리를 해제
@@ -93,6 +100,48 @@ int compare_by_freq( const void *n1, const void *n2){
 	else return compare_by_word(n1, n2);
 }
 
+// 빈도순 정렬 (counting sort)
+// 사전은 단어순으로 저장되어 있으므로 빈도별로 순서대로(stable) 나누면 빈도가 같은 단어는 단어순을 유지
+// compare_by_freq로 qsort한 결과와 같고, 시간은 O(단어 수 + 최대 빈도)
+// return	1 if successful
+//			0 if overflow
+int sort_by_freq( tWordDic *dic){
+	int max_freq = 0;
+	int *start;
+	tWord *sorted;
+
+	if (dic->len <= 0) {
+		return 1;
+	}
+	for (int i = 0; i < dic->len; i++) {
+		if (dic->data[i].freq > max_freq) max_freq = dic->data[i].freq;
+	}
+
+	start = (int *)calloc(max_freq + 2, sizeof(int)); // start[max_freq - f] : 빈도 f인 단어가 들어갈 위치
+	sorted = (tWord *)malloc(dic->len * sizeof(tWord));
+	if (!start || !sorted) {
+		free(start);
+		free(sorted);
+		return 0;
+	}
+
+	for (int i = 0; i < dic->len; i++) {
+		start[max_freq - dic->data[i].freq + 1]++;
+	}
+	for (int k = 1; k <= max_freq + 1; k++) {
+		start[k] += start[k - 1];
+	}
+	for (int i = 0; i < dic->len; i++) {
+		sorted[start[max_freq - dic->data[i].freq]++] = dic->data[i];
+	}
+
+	free(dic->data);
+	dic->data = sorted;
+	dic->capacity = dic->len;
+	free(start);
+	return 1;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // 이진탐색 함수
 // found : key가 발견되는 경우 1, key가 발견되지 않는 경우 0
@@ -181,7 +230,9 @@ int main(int argc, char **argv)
 
 	// 정렬 (빈도 내림차순, 빈도가 같은 경우 단어순)
 	if (option == SORT_BY_FREQ) {
-		qsort(dic->data, dic->len, sizeof(tWord), compare_by_freq);
+		if (!sort_by_freq(dic)) {
+			qsort(dic->data, dic->len, sizeof(tWord), compare_by_freq);
+		}
 	}
 		
 	// 사전을 화면에 출력
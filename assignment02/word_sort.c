@@ -0,0 +1,173 @@
+#include <stdlib.h> // malloc, free
+#include <string.h> // strcmp, memcpy
+#include <pthread.h>
+
+#include "word_sort.h"
+
+// bucket이 이보다 작으면 insertion sort
+#define CUTOFF			16
+#define MAX_THREAD		64
+
+// internal function
+// insertion sort of words that share the first depth characters
+static void _insertion_sort( tWord *data, int n, int depth){
+	for (int i = 1; i < n; i++) {
+		tWord temp = data[i];
+		int j = i;
+		while (j > 0 && strcmp(data[j - 1].word + depth, temp.word + depth) > 0) {
+			data[j] = data[j - 1];
+			j--;
+		}
+		data[j] = temp;
+	}
+}
+
+// internal function
+// distributes data by the character at depth (stable)
+// ch[i] caches the character of data[i] so each word is read once per level
+// bound[c] : end of bucket c (start of bucket c is bound[c-1], 0 for c == 0)
+static void _distribute( tWord *data, tWord *aux, unsigned char *ch, int n, int depth, int *bound){
+	int start[257] = {0};
+
+	for (int i = 0; i < n; i++) {
+		ch[i] = (unsigned char)data[i].word[depth];
+		start[ch[i] + 1]++;
+	}
+	for (int c = 0; c < 256; c++) {
+		start[c + 1] += start[c];
+	}
+	for (int i = 0; i < n; i++) {
+		aux[start[ch[i]]++] = data[i];
+	}
+	memcpy(data, aux, n * sizeof(tWord));
+
+	for (int c = 0; c < 256; c++) {
+		bound[c] = start[c];
+	}
+}
+
+// internal function
+// MSD radix sort of words that share the first depth characters
+// aux, ch : work space of n entries
+static void _msd( tWord *data, tWord *aux, unsigned char *ch, int n, int depth){
+	int bound[256];
+
+	if (n <= CUTOFF) {
+		_insertion_sort(data, n, depth);
+		return;
+	}
+
+	_distribute(data, aux, ch, n, depth, bound);
+
+	// bucket 0 : 여기서 끝나는 단어 (모두 같은 단어이므로 정렬 끝)
+	for (int c = 1; c < 256; c++) {
+		int lo = bound[c - 1], hi = bound[c];
+		if (hi - lo > 1) {
+			_msd(data + lo, aux + lo, ch + lo, hi - lo, depth + 1);
+		}
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int sort_by_word( tWord *data, int n){
+	tWord *aux;
+	unsigned char *ch;
+
+	if (n <= CUTOFF) {
+		_insertion_sort(data, n, 0);
+		return 1;
+	}
+
+	aux = (tWord *)malloc(n * sizeof(tWord));
+	ch = (unsigned char *)malloc(n);
+	if (!aux || !ch) {
+		free(aux);
+		free(ch);
+		return 0;
+	}
+
+	_msd(data, aux, ch, n, 0);
+
+	free(aux);
+	free(ch);
+	return 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// parallel sort
+// the first level is distributed by one thread, then threads take first-letter buckets
+// (largest first) and sort them independently; buckets use disjoint parts of aux and ch
+
+typedef struct {
+	tWord			*data;
+	tWord			*aux;
+	unsigned char	*ch;
+	int				*bound;
+	int				*order;		// buckets in decreasing size
+	int				next;		// next index of order (shared)
+} PARALLEL;
+
+static void *_worker( void *p){
+	PARALLEL *arg = (PARALLEL *)p;
+	int k;
+
+	while ((k = __atomic_fetch_add(&arg->next, 1, __ATOMIC_RELAXED)) < 255) {
+		int c = arg->order[k];
+		int lo = arg->bound[c - 1], hi = arg->bound[c];
+		if (hi - lo > 1) {
+			_msd(arg->data + lo, arg->aux + lo, arg->ch + lo, hi - lo, 1);
+		}
+	}
+	return NULL;
+}
+
+int sort_by_word_parallel( tWord *data, int n, int num_thread){
+	pthread_t thread[MAX_THREAD];
+	int bound[256], order[255];
+	int created = 1;
+	PARALLEL arg;
+
+	if (num_thread > MAX_THREAD) num_thread = MAX_THREAD;
+	if (num_thread <= 1 || n <= CUTOFF) {
+		return sort_by_word(data, n);
+	}
+
+	arg.aux = (tWord *)malloc(n * sizeof(tWord));
+	arg.ch = (unsigned char *)malloc(n);
+	if (!arg.aux || !arg.ch) {
+		free(arg.aux);
+		free(arg.ch);
+		return 0;
+	}
+
+	_distribute(data, arg.aux, arg.ch, n, 0, bound);
+
+	// 큰 bucket부터 (insertion sort, 255개)
+	for (int c = 1; c < 256; c++) {
+		int size = bound[c] - bound[c - 1];
+		int k = c - 1;
+		while (k > 0 && bound[order[k - 1]] - bound[order[k - 1] - 1] < size) {
+			order[k] = order[k - 1];
+			k--;
+		}
+		order[k] = c;
+	}
+
+	arg.data = data;
+	arg.bound = bound;
+	arg.order = order;
+	arg.next = 0;
+
+	// 스레드를 만들지 못하면 남은 bucket은 현재 스레드가 정렬
+	for (int t = 1; t < num_thread; t++, created++) {
+		if (pthread_create(&thread[t], NULL, _worker, &arg) != 0) break;
+	}
+	_worker(&arg);
+	for (int t = 1; t < created; t++) {
+		pthread_join(thread[t], NULL);
+	}
+
+	free(arg.aux);
+	free(arg.ch);
+	return 1;
+}
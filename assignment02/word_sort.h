@@ -0,0 +1,21 @@
+////////////////////////////////////////////////////////////////////////////////
+// 단어 배열 정렬 (MSD radix sort)
+// qsort( data, n, sizeof(tWord), compare_by_word)와 같은 순서 (strcmp 순, stable)
+// 한 글자씩 bucket으로 나누므로 비교 함수 호출과 반복되는 strcmp가 없음
+
+// 단어 구조체
+typedef struct {
+	char	*word;		// 단어
+	int		freq;		// 빈도
+} tWord;
+
+// sorts data by word
+// return	1 if successful
+//			0 if overflow
+int sort_by_word( tWord *data, int n);
+
+// the same sort on num_thread threads
+// 첫 글자로 나눈 bucket들을 여러 스레드가 나누어 정렬
+// return	1 if successful
+//			0 if overflow
+int sort_by_word_parallel( tWord *data, int n, int num_thread);
@@ -26,6 +26,7 @@ typedef struct
 	int		count;
 	NODE	*head; // 단어순 리스트의 첫번째 노드에 대한 포인터
 	NODE	*head2; // 빈도순 리스트의 첫번째 노드에 대한 포인터
+	NODE	*finger; // 마지막 _search의 pPre (단어순 리스트), 다음 _search의 시작 위치
 } LIST;
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -44,6 +45,7 @@ LIST *createList(void) {
         list->count = 0;
         list->head = NULL;
         list->head2 = NULL;
+        list->finger = NULL;
     }
     return list;
 }
@@ -64,16 +66,24 @@ void destroyList( LIST *pList){
 
 // internal search function
 // searches list and passes back address of node containing target and its logical predecessor
+// a word after the last predecessor (finger) is searched from the finger, others from head
+// (정렬된 입력은 단어마다 O(1))
 // for update_dic function
 // return	1 found
 // 			0 not found
 static int _search( LIST *pList, NODE **pPre, NODE **pLoc, tWord *pArgu) {
-    *pPre = NULL;
-    *pLoc = pList->head;
+    if (pList->finger != NULL && compare_by_word(pArgu, pList->finger->dataPtr) > 0) {
+        *pPre = pList->finger;
+        *pLoc = pList->finger->link;
+    } else {
+        *pPre = NULL;
+        *pLoc = pList->head;
+    }
     while (*pLoc != NULL && compare_by_word(pArgu, (*pLoc)->dataPtr) > 0) {
         *pPre = *pLoc;
         *pLoc = (*pLoc)->link;
     }
+    pList->finger = *pPre;
     return (*pLoc != NULL && compare_by_word(pArgu, (*pLoc)->dataPtr) == 0);
 }
 
@@ -147,10 +157,45 @@ static void _link_by_freq( LIST *pList, NODE *pPre, NODE *pLoc) {
 }
 
 // 단어순 리스트를 순회하며 빈도순 리스트로 연결
+// 빈도별 bucket의 끝에 차례로 붙이므로(counting sort) 빈도가 같은 단어는 단어순을 유지
+// O(단어 수 + 최대 빈도), bucket을 할당하지 못하면 _search_by_freq로 하나씩 삽입
 void connect_by_frequency( LIST *list){
     NODE *pNow = list->head;
     NODE *pPre2 = NULL, *pLoc2 = NULL;
+    NODE **first, **last; // 빈도 f인 단어들의 첫번째, 마지막 노드
+    int max_freq = 0;
+
+    for (pNow = list->head; pNow != NULL; pNow = pNow->link) {
+        if (pNow->dataPtr->freq > max_freq) max_freq = pNow->dataPtr->freq;
+    }
+
+    first = (NODE **)calloc(max_freq + 1, sizeof(NODE *));
+    last = (NODE **)calloc(max_freq + 1, sizeof(NODE *));
+    if (first && last) {
+        for (pNow = list->head; pNow != NULL; pNow = pNow->link) {
+            int f = pNow->dataPtr->freq;
+            pNow->link2 = NULL;
+            if (first[f] == NULL) first[f] = pNow;
+            else last[f]->link2 = pNow;
+            last[f] = pNow;
+        }
+
+        // 빈도 내림차순으로 bucket 연결
+        list->head2 = NULL;
+        for (int f = 0; f <= max_freq; f++) {
+            if (first[f] != NULL) {
+                last[f]->link2 = list->head2;
+                list->head2 = first[f];
+            }
+        }
+        free(first);
+        free(last);
+        return;
+    }
+    free(first);
+    free(last);
 
+    pNow = list->head;
     while (pNow != NULL) {
         _search_by_freq(list, &pPre2, &pLoc2, pNow->dataPtr);
         _link_by_freq(list, pPre2, pNow);
@@ -0,0 +1,356 @@
+#include <stdlib.h> // malloc, calloc
+#include <stdint.h> // uintptr_t
+
+#include "adt_cskiplist.h"
+
+// lock-free skip list (Herlihy, Shavit)
+// a node is removed by marking its next pointers (top level first, level 0 last);
+// the thread that marks level 0 owns the removal, and any thread that meets a marked
+// node during a search unlinks it with CAS
+// level 0 decides membership : a node is in the list from the CAS that links it at level 0
+// until the CAS that marks its level 0 pointer
+// the adder may still link upper levels after the remover has unlinked the node,
+// so both hold a link on the node and whichever finishes last retires it
+
+#define MARKED(p)	((uintptr_t)(p) & 1)
+#define MARK(p)		((CNODE *)((uintptr_t)(p) | 1))
+#define UNMARK(p)	((CNODE *)((uintptr_t)(p) & ~(uintptr_t)1))
+
+#define LOAD(p)			__atomic_load_n( (p), __ATOMIC_ACQUIRE)
+#define CAS(p, e, d)	__atomic_compare_exchange_n( (p), (e), (d), 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)
+
+// retired nodes of a thread are checked for reclamation every RECLAIM_BATCH removals
+#define RECLAIM_BATCH	64
+
+////////////////////////////////////////////////////////////////////////////////
+// epoch-based reclamation
+// a thread announces the global epoch when it starts an operation and clears it when done
+// the global epoch moves from e to e+1 only when every thread in an operation has announced e,
+// so a node retired in epoch e cannot be seen by anyone once the global epoch reaches e+2
+
+static void _enter( CLIST *pList, int tid)
+{
+	__atomic_store_n( &pList->slot[tid].epoch, LOAD( &pList->epoch), __ATOMIC_SEQ_CST);
+}
+
+static void _leave( CLIST *pList, int tid)
+{
+	__atomic_store_n( &pList->slot[tid].epoch, 0, __ATOMIC_RELEASE);
+}
+
+static void _try_advance( CLIST *pList)
+{
+	unsigned long epoch = __atomic_load_n( &pList->epoch, __ATOMIC_SEQ_CST);
+
+	for (int t = 0; t < CLIST_MAX_THREAD; t++)
+	{
+		unsigned long e = __atomic_load_n( &pList->slot[t].epoch, __ATOMIC_SEQ_CST);
+		if (e != 0 && e != epoch) return;
+	}
+	CAS( &pList->epoch, &epoch, epoch + 1);
+}
+
+static void _free_node( CNODE *pNode)
+{
+	if (pNode->retire) pNode->retire( pNode->dataPtr);
+	free( pNode);
+}
+
+// frees retired nodes of thread tid that no thread can see any more
+static void _reclaim( CLIST *pList, int tid)
+{
+	CSLOT *slot = &pList->slot[tid];
+	unsigned long epoch;
+	CNODE **link = &slot->retired;
+
+	_try_advance( pList);
+	epoch = LOAD( &pList->epoch);
+
+	while (*link)
+	{
+		CNODE *pNode = *link;
+		if (pNode->retired_epoch + 2 <= epoch)
+		{
+			*link = pNode->retired_link;
+			_free_node( pNode);
+			slot->num_retired--;
+		}
+		else link = &pNode->retired_link;
+	}
+}
+
+// drops one link of the node; the last one puts it on the retire list of thread tid
+static void _retire( CLIST *pList, int tid, CNODE *pNode)
+{
+	CSLOT *slot = &pList->slot[tid];
+
+	// still in the list, or the adder is not done linking it
+	if (__atomic_sub_fetch( &pNode->links, 1, __ATOMIC_ACQ_REL) != 0) return;
+
+	pNode->retired_epoch = LOAD( &pList->epoch);
+	pNode->retired_link = slot->retired;
+	slot->retired = pNode;
+
+	if (++slot->num_retired >= RECLAIM_BATCH) _reclaim( pList, tid);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// internal function
+// random level of a new node (1 .. CLIST_MAX_LEVEL), promoted with probability 1/4
+static int _random_level( CLIST *pList, int tid)
+{
+	unsigned int seed = pList->slot[tid].seed; // xorshift32
+	int level = 1;
+
+	seed ^= seed << 13;
+	seed ^= seed >> 17;
+	seed ^= seed << 5;
+	pList->slot[tid].seed = seed;
+
+	for (unsigned int bits = seed; level < CLIST_MAX_LEVEL && (bits & 3) == 0; bits >>= 2){
+		level++;
+	}
+	return level;
+}
+
+// internal search function
+// preds[i] : last node before key at level i, succs[i] : its successor
+// marked nodes on the way are unlinked
+// return	1 found (succs[0])
+// 			0 not found
+static int _search( CLIST *pList, void *keyPtr, CNODE **preds, CNODE **succs)
+{
+	CNODE *pPre, *pCur, *pNext;
+
+retry:
+	pPre = pList->head;
+	for (int i = CLIST_MAX_LEVEL - 1; i >= 0; i--)
+	{
+		pCur = LOAD( &pPre->next[i]);
+		if (MARKED( pCur)) goto retry; // pPre was removed meanwhile
+
+		while (pCur != NULL)
+		{
+			pNext = LOAD( &pCur->next[i]);
+			if (MARKED( pNext)) // pCur is removed : unlink at level i
+			{
+				CNODE *expected = pCur;
+				if (!CAS( &pPre->next[i], &expected, UNMARK( pNext))) goto retry;
+				pCur = UNMARK( pNext);
+				continue;
+			}
+			if (pList->compare( pCur->dataPtr, keyPtr) >= 0) break;
+			pPre = pCur;
+			pCur = pNext;
+		}
+		preds[i] = pPre;
+		succs[i] = pCur;
+	}
+	return (succs[0] != NULL && pList->compare( succs[0]->dataPtr, keyPtr) == 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+CLIST *clist_Create( int (*compare)(const void *, const void *))
+{
+	CLIST *list = (CLIST *)calloc( 1, sizeof(CLIST));
+	if (!list) return NULL;
+
+	list->head = (CNODE *)calloc( 1, sizeof(CNODE) + CLIST_MAX_LEVEL * sizeof(CNODE *));
+	if (!list->head)
+	{
+		free( list);
+		return NULL;
+	}
+	list->head->level = CLIST_MAX_LEVEL;
+	list->epoch = 1;
+	list->compare = compare;
+
+	for (int t = 0; t < CLIST_MAX_THREAD; t++)
+		list->slot[t].seed = 2463534242u + 2654435761u * t;
+
+	return list;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void clist_Destroy( CLIST *pList, void (*callback)(void *))
+{
+	CNODE *pNode = pList->head->next[0];
+
+	while (pNode != NULL)
+	{
+		CNODE *pNext = UNMARK( pNode->next[0]);
+		if (!MARKED( pNode->next[0])) // removed nodes are freed from the retire lists
+		{
+			callback( pNode->dataPtr);
+			free( pNode);
+		}
+		pNode = pNext;
+	}
+
+	for (int t = 0; t < CLIST_MAX_THREAD; t++)
+	{
+		while (pList->slot[t].retired)
+		{
+			pNode = pList->slot[t].retired;
+			pList->slot[t].retired = pNode->retired_link;
+			_free_node( pNode);
+		}
+	}
+
+	free( pList->head);
+	free( pList);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int clist_Add( CLIST *pList, int tid, void *dataInPtr, void (*callback)(const void *))
+{
+	CNODE *preds[CLIST_MAX_LEVEL], *succs[CLIST_MAX_LEVEL];
+	CNODE *newNode = NULL;
+	int level = _random_level( pList, tid);
+
+	_enter( pList, tid);
+
+	// level 0
+	while (1)
+	{
+		if (_search( pList, dataInPtr, preds, succs))
+		{
+			callback( succs[0]->dataPtr);
+			_leave( pList, tid);
+			free( newNode);
+			return 2;
+		}
+
+		if (!newNode)
+		{
+			newNode = (CNODE *)malloc( sizeof(CNODE) + level * sizeof(CNODE *));
+			if (!newNode)
+			{
+				_leave( pList, tid);
+				return 0;
+			}
+			newNode->dataPtr = dataInPtr;
+			newNode->level = level;
+			newNode->links = 2;
+			newNode->retire = NULL;
+		}
+		for (int i = 0; i < level; i++) newNode->next[i] = succs[i];
+
+		CNODE *expected = succs[0];
+		if (CAS( &preds[0]->next[0], &expected, newNode)) break;
+	}
+	__atomic_fetch_add( &pList->count, 1, __ATOMIC_RELAXED);
+
+	// upper levels
+	for (int i = 1; i < level; i++)
+	{
+		while (1)
+		{
+			CNODE *pNext = LOAD( &newNode->next[i]);
+			if (MARKED( pNext)) goto done; // removed meanwhile
+			if (pNext != succs[i] && !CAS( &newNode->next[i], &pNext, succs[i])) goto done;
+
+			CNODE *expected = succs[i];
+			if (CAS( &preds[i]->next[i], &expected, newNode)) break;
+
+			// preds / succs changed
+			if (!_search( pList, dataInPtr, preds, succs) || succs[0] != newNode) goto done;
+		}
+	}
+
+done:
+	// a remover may have searched past a level before it was linked here : unlink it again
+	if (MARKED( LOAD( &newNode->next[0]))) _search( pList, dataInPtr, preds, succs);
+
+	_retire( pList, tid, newNode); // drops the adder's link
+
+	_leave( pList, tid);
+	return 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int clist_Remove( CLIST *pList, int tid, void *keyPtr, void (*retire)(void *))
+{
+	CNODE *preds[CLIST_MAX_LEVEL], *succs[CLIST_MAX_LEVEL];
+	CNODE *pLoc, *pNext;
+
+	_enter( pList, tid);
+
+	if (!_search( pList, keyPtr, preds, succs))
+	{
+		_leave( pList, tid);
+		return 0;
+	}
+	pLoc = succs[0];
+
+	for (int i = pLoc->level - 1; i >= 1; i--)
+	{
+		pNext = LOAD( &pLoc->next[i]);
+		while (!MARKED( pNext) && !CAS( &pLoc->next[i], &pNext, MARK( pNext)))
+			;
+	}
+
+	pNext = LOAD( &pLoc->next[0]);
+	while (1)
+	{
+		if (MARKED( pNext)) // removed by another thread
+		{
+			_leave( pList, tid);
+			return 0;
+		}
+		if (CAS( &pLoc->next[0], &pNext, MARK( pNext))) break;
+	}
+	__atomic_fetch_sub( &pList->count, 1, __ATOMIC_RELAXED);
+
+	_search( pList, keyPtr, preds, succs); // unlink at all levels
+
+	pLoc->retire = retire;
+	_retire( pList, tid, pLoc); // drops the remover's link
+
+	_leave( pList, tid);
+	return 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void *clist_Search( CLIST *pList, int tid, void *keyPtr)
+{
+	CNODE *preds[CLIST_MAX_LEVEL], *succs[CLIST_MAX_LEVEL];
+	void *dataPtr = NULL;
+
+	_enter( pList, tid);
+	if (_search( pList, keyPtr, preds, succs)) dataPtr = succs[0]->dataPtr;
+	_leave( pList, tid);
+
+	return dataPtr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int clist_SearchApply( CLIST *pList, int tid, void *keyPtr, int (*callback)(const void *))
+{
+	CNODE *preds[CLIST_MAX_LEVEL], *succs[CLIST_MAX_LEVEL];
+	int ret = 0;
+
+	_enter( pList, tid);
+	if (_search( pList, keyPtr, preds, succs)) ret = callback( succs[0]->dataPtr);
+	_leave( pList, tid);
+
+	return ret;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long clist_Count( CLIST *pList)
+{
+	return __atomic_load_n( &pList->count, __ATOMIC_RELAXED);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void clist_Traverse( CLIST *pList, void (*callback)(const void *))
+{
+	CNODE *pNode = pList->head->next[0];
+
+	while (pNode != NULL)
+	{
+		if (!MARKED( pNode->next[0])) callback( pNode->dataPtr);
+		pNode = UNMARK( pNode->next[0]);
+	}
+}
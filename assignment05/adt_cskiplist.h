@@ -0,0 +1,83 @@
+////////////////////////////////////////////////////////////////////////////////
+// concurrent (lock-free) skip list type definition
+// several threads may call clist_Add, clist_Remove and clist_Search at the same time
+// each thread passes its own thread number tid (0 .. CLIST_MAX_THREAD-1)
+// removed nodes are freed by epoch-based reclamation after no thread can still see them
+#define CLIST_MAX_LEVEL		16
+#define CLIST_MAX_THREAD	64
+
+typedef struct cnode
+{
+	void			*dataPtr;
+	int				level;
+	int				links;				// adder + remover : the one that drops the last link retires the node
+	void			(*retire)(void *);	// frees dataPtr after the node is reclaimed
+	unsigned long	retired_epoch;
+	struct cnode	*retired_link;		// retire list of the removing thread
+	struct cnode	*next[];			// next[i] : next node at level i, bit 0 marks a removed node
+} CNODE;
+
+// per-thread state, padded to a cache line
+typedef struct
+{
+	unsigned long	epoch;		// announced epoch while in an operation, 0 if quiescent
+	unsigned int	seed;		// random level
+	int				num_retired;
+	CNODE			*retired;
+	char			pad[40];
+} CSLOT;
+
+typedef struct
+{
+	CNODE			*head;		// sentinel with CLIST_MAX_LEVEL levels
+	long			count;
+	unsigned long	epoch;		// global epoch (starts at 1)
+	int				(*compare)(const void *, const void *);
+	CSLOT			slot[CLIST_MAX_THREAD];
+} CLIST;
+
+////////////////////////////////////////////////////////////////////////////////
+// function declarations
+
+// Allocates dynamic memory for a list head node and returns its address to caller
+// return	head node pointer
+// 			NULL if overflow
+CLIST *clist_Create( int (*compare)(const void *, const void *));
+
+// 리스트에 할당된 메모리를 해제 (head node, data node, retired node)
+// no other thread may use the list
+void clist_Destroy( CLIST *pList, void (*callback)(void *));
+
+// Inserts data into list
+// callback은 이미 리스트에 존재하는 데이터를 발견했을 때 호출하는 함수
+// callback may run concurrently for the same data (e.g. use an atomic increment)
+//	return	0 if overflow
+//			1 if successful
+//			2 if duplicated key
+int clist_Add( CLIST *pList, int tid, void *dataInPtr, void (*callback)(const void *));
+
+// Removes data from list
+// retire(data) is called when no other thread can access the data any more
+//	return	0 not found
+//			1 deleted
+int clist_Remove( CLIST *pList, int tid, void *keyPtr, void (*retire)(void *));
+
+// Retrieve data containing the requested key (keyPtr)
+// the returned data is not protected : a concurrent clist_Remove may retire it at any time,
+// so dereference it only when no other thread removes this key (use clist_SearchApply otherwise)
+//	return	address of data
+//			NULL not found
+void *clist_Search( CLIST *pList, int tid, void *keyPtr);
+
+// Calls callback with the data containing the requested key (keyPtr)
+// callback runs while the data cannot be reclaimed
+//	return	return value of callback
+//			0 not found
+int clist_SearchApply( CLIST *pList, int tid, void *keyPtr, int (*callback)(const void *));
+
+// returns number of nodes in list
+long clist_Count( CLIST *pList);
+
+// traverses data from list (forward)
+// no other thread may modify the list
+void clist_Traverse( CLIST *pList, void (*callback)(const void *));
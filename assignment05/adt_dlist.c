@@ -2,6 +2,21 @@
 
 #include "adt_dlist.h"
 
+// statistics (-DSTATS), see statsList
+#ifdef STATS
+static struct {
+	long compare;		// compare calls
+	long search;		// _search calls
+	long visit;			// nodes visited by _search
+	long malloc_bytes;	// nodes allocated
+} stats;
+#define STAT(x)		(x)
+#else
+#define STAT(x)		((void)0)
+#endif
+
+#define COMPARE(list, a, b)	(STAT(stats.compare++), (list)->compare( (a), (b)))
+
 // internal insert function
 // inserts data into list
 // for addNode function
@@ -12,6 +27,7 @@ static int _insert( LIST *pList, NODE *pPre, void *dataInPtr){
 	if(!newNode){
 		return 0;
 	}
+	STAT(stats.malloc_bytes += sizeof(NODE));
 	newNode->dataPtr = dataInPtr;
 	if (pPre == NULL){ //empty or beginning
 		newNode->rlink = pList->head;
@@ -35,6 +51,7 @@ static int _insert( LIST *pList, NODE *pPre, void *dataInPtr){
 		pPre->rlink = newNode;
 	}
 
+	pList->finger = newNode;
 	pList->count++;
 	return 1;
 };
@@ -61,6 +78,7 @@ static void _delete( LIST *pList, NODE *pPre, NODE *pLoc, void **dataOutPtr){
 		}
 	}
 
+	pList->finger = (pPre != NULL) ? pPre : pList->head;
 	free(pLoc);
 	pList->count--;
 
@@ -71,17 +89,37 @@ static void _delete( LIST *pList, NODE *pPre, NODE *pLoc, void **dataOutPtr){
 
 // internal search function
 // searches list and passes back address of node containing target and its logical predecessor
+// the search starts from the last accessed node (finger) and moves forward or backward,
+// so sorted or nearly sorted input costs O(1) per word instead of O(n)
 // for addNode, removeNode, searchNode functions
 // return 1 found
 // 0 not found
 static int _search(LIST *pList, NODE **pPre, NODE **pLoc, void *pArgu) {
-    *pPre = NULL;
-    *pLoc = pList->head;
-    while (*pLoc != NULL && pList->compare(pArgu, (*pLoc)->dataPtr) > 0) {
-        *pPre = *pLoc;
-        *pLoc = (*pLoc)->rlink;
+    NODE *pFinger = pList->finger;
+
+    STAT(stats.search++);
+    if (pFinger == NULL) { //empty
+        *pPre = NULL;
+        *pLoc = pList->head;
+    } else if (COMPARE(pList, pArgu, pFinger->dataPtr) > 0) { //forward
+        *pPre = pFinger;
+        *pLoc = pFinger->rlink;
+        while (*pLoc != NULL && COMPARE(pList, pArgu, (*pLoc)->dataPtr) > 0) {
+            *pPre = *pLoc;
+            *pLoc = (*pLoc)->rlink;
+            STAT(stats.visit++);
+        }
+    } else { //backward
+        *pLoc = pFinger;
+        while ((*pLoc)->llink != NULL && COMPARE(pList, pArgu, (*pLoc)->llink->dataPtr) <= 0) {
+            *pLoc = (*pLoc)->llink;
+            STAT(stats.visit++);
+        }
+        *pPre = (*pLoc)->llink;
     }
-    return (*pLoc != NULL && pList->compare(pArgu, (*pLoc)->dataPtr) == 0);
+
+    pList->finger = (*pLoc != NULL) ? *pLoc : *pPre;
+    return (*pLoc != NULL && COMPARE(pList, pArgu, (*pLoc)->dataPtr) == 0);
 }
 
 
@@ -95,6 +133,7 @@ LIST *createList(int (*compare)(const void *, const void *)){
         list->head = NULL;
         list->rear = NULL;
         list->compare = compare;
+        list->finger = NULL;
     }
     return list;
 }
@@ -173,11 +212,7 @@ int countList( LIST *pList){
 // returns	1 empty
 //			0 list has data
 int emptyList( LIST *pList){
-	if (pList->count == 0){
-		return 0;
-	} else {
-		return 1;
-	}
+	return pList->count == 0;
 }
 
 
@@ -197,4 +232,14 @@ void traverseListR( LIST *pList, void (*callback)(const void *)){
 		callback(pNode->dataPtr);
 		pNode = pNode->llink;
 	}
-}
\ No newline at end of file
+}
+
+// prints the counters as one line of JSON (-DSTATS)
+void statsList( FILE *fp){
+#ifdef STATS
+	fprintf(fp, "{\"adt\": \"dlist\", \"compare\": %ld, \"search\": %ld, \"visit\": %ld, \"malloc_bytes\": %ld}\n",
+		stats.compare, stats.search, stats.visit, stats.malloc_bytes);
+#else
+	(void)fp;
+#endif
+}
@@ -1,6 +1,11 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 // LIST type definition
+// adt_dlist.c : doubly linked list
+// adt_skiplist.c : skip list (the same functions, expected O(log n) search)
+//                  its nodes and list head extend NODE and LIST privately
+#include <stdio.h> // FILE
+
 typedef struct node
 {
 	void		*dataPtr;
@@ -14,6 +19,7 @@ typedef struct
 	NODE	*head;
 	NODE	*rear;
 	int		(*compare)(const void *, const void *); // used in _search function
+	NODE	*finger;	// doubly linked list : last accessed node, _search starts here
 } LIST;
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -58,3 +64,8 @@ void traverseList( LIST *pList, void (*callback)(const void *));
 
 // traverses data from list (backward)
 void traverseListR( LIST *pList, void (*callback)(const void *));
+
+// prints the counters of list operations as one line of JSON
+// (compare calls, searches, nodes visited by searches, bytes allocated for nodes)
+// the counters are compiled in with -DSTATS (make CFLAGS=-DSTATS); otherwise nothing is printed
+void statsList( FILE *fp);
@@ -0,0 +1,274 @@
+#include <stdlib.h> // malloc
+
+#include "adt_dlist.h"
+
+// statistics (-DSTATS), see statsList
+#ifdef STATS
+static struct {
+	long compare;		// compare calls
+	long search;		// _search calls
+	long visit;			// nodes visited by _search (all levels)
+	long malloc_bytes;	// nodes with their links
+} stats;
+#define STAT(x)		(x)
+#else
+#define STAT(x)		((void)0)
+#endif
+
+#define COMPARE(list, a, b)	(STAT(stats.compare++), (list)->compare( (a), (b)))
+
+// skip list
+// level 0 is the doubly linked list (head, rear, llink, rlink) so traverseList and traverseListR are unchanged
+// a node is promoted to the next level with probability 1/4
+
+#define MAX_LEVEL	16 // enough for 4^16 nodes
+
+// skip list node : NODE (level 0) followed by the links of the upper levels
+typedef struct
+{
+	NODE	node;
+	int		level;		// number of levels of the node
+	NODE	*next[];	// next[i-1] is the next node at level i
+} SNODE;
+
+// skip list head : LIST followed by the first nodes of the upper levels
+typedef struct
+{
+	LIST	list;
+	int		level;				// highest level in use
+	NODE	*top[MAX_LEVEL];	// first node at level i (top[0] is not used, level 0 is head)
+} SLIST;
+
+#define SNODE_OF(p)	((SNODE *)(p))
+#define SLIST_OF(p)	((SLIST *)(p))
+
+// internal function
+// returns address of the link to the next node at level i
+// pNode == NULL means the list head
+static NODE **_link( LIST *pList, NODE *pNode, int i){
+	if (pNode == NULL){
+		return (i == 0) ? &pList->head : &SLIST_OF(pList)->top[i];
+	}
+	return (i == 0) ? &pNode->rlink : &SNODE_OF(pNode)->next[i - 1];
+}
+
+// internal function
+// random level of a new node (1 .. MAX_LEVEL)
+static int _random_level(void){
+	static unsigned int seed = 2463534242u; // xorshift32
+	int level = 1;
+
+	seed ^= seed << 13;
+	seed ^= seed >> 17;
+	seed ^= seed << 5;
+
+	for (unsigned int bits = seed; level < MAX_LEVEL && (bits & 3) == 0; bits >>= 2){
+		level++;
+	}
+	return level;
+}
+
+// internal search function
+// searches list and passes back address of node containing target and its logical predecessor
+// update[i] : last node before target at level i (NULL = head)
+// for addNode, removeNode, searchNode functions
+// return	1 found
+// 			0 not found
+static int _search( LIST *pList, NODE **update, NODE **pLoc, void *pArgu){
+	NODE *pPre = NULL;
+	NODE *pNext;
+
+	STAT(stats.search++);
+	for (int i = SLIST_OF(pList)->level - 1; i >= 0; i--){
+		while ((pNext = *_link(pList, pPre, i)) != NULL && COMPARE(pList, pArgu, pNext->dataPtr) > 0){
+			pPre = pNext;
+			STAT(stats.visit++);
+		}
+		update[i] = pPre;
+	}
+
+	*pLoc = *_link(pList, pPre, 0);
+	return (*pLoc != NULL && COMPARE(pList, pArgu, (*pLoc)->dataPtr) == 0);
+}
+
+// internal insert function
+// inserts data after update[i] at each level of the new node
+// for addNode function
+// return	1 if successful
+// 			0 if memory overflow
+static int _insert( LIST *pList, NODE **update, void *dataInPtr){
+	int level = _random_level();
+	NODE *pPre = update[0];
+	SLIST *sList = SLIST_OF(pList);
+
+	// links for level 1 .. level-1 are allocated with the node
+	SNODE *sNode = (SNODE *)malloc(sizeof(SNODE) + (level - 1) * sizeof(NODE *));
+	NODE *newNode;
+	if (!sNode){
+		return 0;
+	}
+	newNode = &sNode->node;
+	STAT(stats.malloc_bytes += sizeof(SNODE) + (level - 1) * sizeof(NODE *));
+	newNode->dataPtr = dataInPtr;
+	sNode->level = level;
+
+	while (sList->level < level){ // new levels start from head
+		update[sList->level++] = NULL;
+	}
+
+	for (int i = 1; i < level; i++){
+		NODE **link = _link(pList, update[i], i);
+		sNode->next[i - 1] = *link;
+		*link = newNode;
+	}
+
+	// level 0 (doubly linked)
+	newNode->llink = pPre;
+	newNode->rlink = *_link(pList, pPre, 0);
+	if (newNode->rlink == NULL){ //end
+		pList->rear = newNode;
+	} else { //beginning or middle
+		newNode->rlink->llink = newNode;
+	}
+	*_link(pList, pPre, 0) = newNode;
+
+	pList->count++;
+	return 1;
+}
+
+// internal delete function
+// deletes data from list and saves the (deleted) data to dataOutPtr
+// for removeNode function
+static void _delete( LIST *pList, NODE **update, NODE *pLoc, void **dataOutPtr){
+	*dataOutPtr = pLoc->dataPtr;
+
+	for (int i = 1; i < SNODE_OF(pLoc)->level; i++){
+		*_link(pList, update[i], i) = SNODE_OF(pLoc)->next[i - 1];
+	}
+
+	*_link(pList, update[0], 0) = pLoc->rlink;
+	if (pLoc->rlink == NULL){ //end
+		pList->rear = update[0];
+	} else { //beginning or middle
+		pLoc->rlink->llink = update[0];
+	}
+
+	while (SLIST_OF(pList)->level > 1 && SLIST_OF(pList)->top[SLIST_OF(pList)->level - 1] == NULL){
+		SLIST_OF(pList)->level--;
+	}
+
+	free(pLoc);
+	pList->count--;
+}
+
+// Allocates dynamic memory for a list head node and returns its address to caller
+// return	head node pointer
+// 			NULL if overflow
+LIST *createList(int (*compare)(const void *, const void *)){
+	SLIST *sList = (SLIST *)malloc(sizeof(SLIST));
+	if (!sList) {
+		return NULL;
+	}
+	sList->list.count = 0;
+	sList->list.head = NULL;
+	sList->list.rear = NULL;
+	sList->list.compare = compare;
+	sList->list.finger = NULL; // not used
+	sList->level = 1;
+	for (int i = 0; i < MAX_LEVEL; i++){
+		sList->top[i] = NULL;
+	}
+	return &sList->list;
+}
+
+//  단어 리스트에 할당된 메모리를 해제 (head node, data node, word data)
+void destroyList( LIST *pList, void (*callback)(void *)){
+	NODE *deleteNodePtr;
+	while(pList->head != NULL){
+		deleteNodePtr = pList->head;
+		pList->head = deleteNodePtr->rlink;
+		callback(deleteNodePtr->dataPtr);
+		free(deleteNodePtr);
+	}
+	free(pList);
+}
+
+// Inserts data into list
+// return	0 if overflow
+//			1 if successful
+//			2 if duplicated key (이미 저장된 단어는 빈도 증가)
+int addNode( LIST *pList, void *dataInPtr, void (*callback)(const void *)){
+	NODE *update[MAX_LEVEL], *pLoc;
+	int found = _search(pList, update, &pLoc, dataInPtr);
+
+	if (found == 1) { //찾음
+		callback(pLoc->dataPtr);
+		return 2;
+	}
+	return _insert(pList, update, dataInPtr);
+}
+
+// Removes data from list
+//	return	0 not found
+//			1 deleted
+int removeNode( LIST *pList, void *keyPtr, void **dataOutPtr) {
+	NODE *update[MAX_LEVEL], *pLoc;
+	int found = _search(pList, update, &pLoc, keyPtr);
+	if (found == 1){
+		_delete(pList, update, pLoc, dataOutPtr);
+		return 1;
+	}
+	return 0;
+}
+
+// interface to search function
+//	pArgu	key being sought
+//	dataOutPtr	contains found data
+//	return	1 successful
+//			0 not found
+int searchNode( LIST *pList, void *pArgu, void **dataOutPtr){
+	NODE *update[MAX_LEVEL], *pLoc;
+	int found = _search(pList, update, &pLoc, pArgu);
+
+	*dataOutPtr = found ? pLoc->dataPtr : NULL;
+	return found;
+}
+
+// returns number of nodes in list
+int countList( LIST *pList){
+	return pList->count;
+}
+
+// returns	1 empty
+//			0 list has data
+int emptyList( LIST *pList){
+	return pList->count == 0;
+}
+
+// traverses data from list (forward)
+void traverseList( LIST *pList, void (*callback)(const void *)){
+	NODE *pNode = pList->head;
+	while(pNode != NULL){
+		callback(pNode->dataPtr);
+		pNode = pNode->rlink;
+	}
+}
+
+// traverses data from list (backward)
+void traverseListR( LIST *pList, void (*callback)(const void *)){
+	NODE *pNode = pList->rear;
+	while(pNode != NULL){
+		callback(pNode->dataPtr);
+		pNode = pNode->llink;
+	}
+}
+
+// prints the counters as one line of JSON (-DSTATS)
+void statsList( FILE *fp){
+#ifdef STATS
+	fprintf(fp, "{\"adt\": \"skiplist\", \"compare\": %ld, \"search\": %ld, \"visit\": %ld, \"malloc_bytes\": %ld}\n",
+		stats.compare, stats.search, stats.visit, stats.malloc_bytes);
+#else
+	(void)fp;
+#endif
+}
@@ -0,0 +1,217 @@
+#include <stdio.h>
+#include <stdlib.h> // malloc, realloc, atoi
+#include <string.h> // strdup, strcmp
+#include <time.h> // clock_gettime
+#include <pthread.h>
+
+#include "adt_cskiplist.h"
+
+// concurrent skip list benchmark
+// the tokens of FILE are counted by 1, 2, 4, ... threads inserting into one shared list,
+// then the words are removed by the same threads
+// usage: cskiplist_bench FILE [max threads]
+
+// User structure type definition
+// 단어 구조체
+typedef struct {
+	char	*word;		// 단어
+	int		freq;		// 빈도
+} tWord;
+
+////////////////////////////////////////////////////////////////////////////////
+tWord *createWord( char *word){
+	tWord *newWord = (tWord*)malloc(sizeof(tWord));
+	if(!newWord){
+		return NULL; //overflow
+	}
+	newWord->word = strdup(word);
+	newWord->freq = 1;
+	return newWord;
+}
+
+void destroyWord( void *pNode){
+	tWord *wordNode = (tWord *)pNode;
+	free(wordNode->word);
+	free(wordNode);
+}
+
+int compare_by_word( const void *n1, const void *n2)
+{
+	return strcmp( ((tWord *)n1)->word, ((tWord *)n2)->word);
+}
+
+// 여러 스레드가 같은 단어의 빈도를 동시에 증가시킴
+void increase_freq(const void *dataPtr)
+{
+	__atomic_fetch_add( &((tWord *)dataPtr)->freq, 1, __ATOMIC_RELAXED);
+}
+
+static long checksum;
+
+void sum_freq(const void *dataPtr)
+{
+	checksum += ((tWord *)dataPtr)->freq;
+}
+
+// 경과 시간 (초)
+static double elapsed( struct timespec *start)
+{
+	struct timespec now;
+	clock_gettime( CLOCK_MONOTONIC, &now);
+	return (now.tv_sec - start->tv_sec) + (now.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// thread argument
+typedef struct {
+	CLIST	*list;
+	char	**tokens;
+	int		num_tokens;
+	int		tid;
+	int		num_thread;
+	long	result;		// removed words
+} ARG;
+
+// token i is inserted by thread i % num_thread
+static void *insert_thread( void *p)
+{
+	ARG *arg = (ARG *)p;
+
+	for (int i = arg->tid; i < arg->num_tokens; i += arg->num_thread)
+	{
+		tWord *pWord = createWord( arg->tokens[i]);
+		int ret = clist_Add( arg->list, arg->tid, pWord, increase_freq);
+		if (ret == 0 || ret == 2) destroyWord( pWord);
+	}
+	return NULL;
+}
+
+// every thread tries to remove every token (same words race)
+static void *remove_thread( void *p)
+{
+	ARG *arg = (ARG *)p;
+
+	arg->result = 0;
+	for (int k = 0; k < arg->num_tokens; k++)
+	{
+		int i = (k + arg->tid * (arg->num_tokens / arg->num_thread)) % arg->num_tokens;
+		tWord key = { arg->tokens[i], 0};
+		arg->result += clist_Remove( arg->list, arg->tid, &key, destroyWord);
+	}
+	return NULL;
+}
+
+// runs func on num_thread threads
+// a share whose thread cannot be created runs on the calling thread
+static void run( void *(*func)(void *), ARG *arg, int num_thread)
+{
+	pthread_t thread[CLIST_MAX_THREAD];
+	int started[CLIST_MAX_THREAD];
+
+	for (int t = 1; t < num_thread; t++)
+	{
+		started[t] = (pthread_create( &thread[t], NULL, func, &arg[t]) == 0);
+		if (!started[t]) fprintf( stderr, "Warning: cannot create thread %d, run on the main thread\n", t);
+	}
+	func( &arg[0]);
+	for (int t = 1; t < num_thread; t++)
+	{
+		if (started[t]) pthread_join( thread[t], NULL);
+		else func( &arg[t]);
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int main( int argc, char **argv)
+{
+	char word[100];
+	char **tokens = NULL;
+	int num_tokens = 0, capacity = 0;
+	int max_thread = 8;
+	FILE *fp;
+
+	if (argc != 2 && argc != 3) {
+		fprintf( stderr, "usage: %s FILE [max threads]\n", argv[0]);
+		return 1;
+	}
+	if (argc == 3) max_thread = atoi( argv[2]);
+	if (max_thread < 1 || max_thread > CLIST_MAX_THREAD)
+	{
+		fprintf( stderr, "Error: threads must be 1 .. %d\n", CLIST_MAX_THREAD);
+		return 1;
+	}
+
+	fp = fopen( argv[1], "rt");
+	if (!fp)
+	{
+		fprintf( stderr, "Error: cannot open file [%s]\n", argv[1]);
+		return 2;
+	}
+
+	// 입력 단어를 미리 메모리에 읽어 둠 (파일 읽기 시간 제외)
+	while (fscanf( fp, "%s", word) != EOF)
+	{
+		if (num_tokens == capacity)
+		{
+			capacity = capacity ? capacity * 2 : 1024;
+			tokens = (char **)realloc( tokens, capacity * sizeof(char *));
+		}
+		tokens[num_tokens++] = strdup( word);
+	}
+	fclose( fp);
+
+	printf( "threads\tinsert(Mops/s)\tremove(Mops/s)\twords\tfreq sum\n");
+
+	for (int num_thread = 1; num_thread <= max_thread; num_thread *= 2)
+	{
+		ARG arg[CLIST_MAX_THREAD];
+		struct timespec start;
+		double t_insert, t_remove;
+		long words, removed = 0;
+		CLIST *list = clist_Create( compare_by_word);
+
+		if (!list)
+		{
+			printf( "Cannot create list\n");
+			return 100;
+		}
+
+		for (int t = 0; t < num_thread; t++)
+		{
+			arg[t].list = list;
+			arg[t].tokens = tokens;
+			arg[t].num_tokens = num_tokens;
+			arg[t].tid = t;
+			arg[t].num_thread = num_thread;
+		}
+
+		clock_gettime( CLOCK_MONOTONIC, &start);
+		run( insert_thread, arg, num_thread);
+		t_insert = elapsed( &start);
+
+		words = clist_Count( list);
+		checksum = 0;
+		clist_Traverse( list, sum_freq);
+
+		clock_gettime( CLOCK_MONOTONIC, &start);
+		run( remove_thread, arg, num_thread);
+		t_remove = elapsed( &start);
+
+		for (int t = 0; t < num_thread; t++) removed += arg[t].result;
+
+		printf( "%d\t%.2f\t\t%.2f\t\t%ld\t%ld\n", num_thread,
+			num_tokens / t_insert / 1e6, (double)num_tokens * num_thread / t_remove / 1e6,
+			words, checksum);
+
+		if (checksum != num_tokens || removed != words || clist_Count( list) != 0)
+			fprintf( stderr, "Error: %d threads : freq sum %ld, removed %ld of %ld\n",
+				num_thread, checksum, removed, words);
+
+		clist_Destroy( list, destroyWord);
+	}
+
+	for (int i = 0; i < num_tokens; i++) free( tokens[i]);
+	free( tokens);
+
+	return 0;
+}
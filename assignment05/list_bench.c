@@ -0,0 +1,146 @@
+#include <stdio.h>
+#include <stdlib.h> // malloc, realloc
+#include <string.h> // strdup, strcmp
+#include <time.h> // clock_gettime
+
+#include "adt_dlist.h"
+
+// list ADT benchmark
+// the same program is linked with adt_dlist.o (list_bench) and adt_skiplist.o (list_bench_s)
+
+// User structure type definition
+// 단어 구조체
+typedef struct {
+	char	*word;		// 단어
+	int		freq;		// 빈도
+} tWord;
+
+////////////////////////////////////////////////////////////////////////////////
+tWord *createWord( char *word){
+	tWord *newWord = (tWord*)malloc(sizeof(tWord));
+	if(!newWord){
+		return NULL; //overflow
+	}
+	newWord->word = strdup(word);
+	newWord->freq = 1;
+	return newWord;
+}
+
+void destroyWord( void *pNode){
+	tWord *wordNode = (tWord *)pNode;
+	free(wordNode->word);
+	free(wordNode);
+}
+
+int compare_by_word( const void *n1, const void *n2)
+{
+	return strcmp( ((tWord *)n1)->word, ((tWord *)n2)->word);
+}
+
+void increase_freq(const void *dataPtr)
+{
+	((tWord *)dataPtr)->freq++;
+}
+
+static long checksum;
+
+void sum_freq(const void *dataPtr)
+{
+	checksum += ((tWord *)dataPtr)->freq;
+}
+
+// 경과 시간 (초)
+static double elapsed( struct timespec *start)
+{
+	struct timespec now;
+	clock_gettime( CLOCK_MONOTONIC, &now);
+	return (now.tv_sec - start->tv_sec) + (now.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int main( int argc, char **argv)
+{
+	LIST *list;
+	char word[100];
+	char **tokens = NULL;
+	int num_tokens = 0, capacity = 0;
+	struct timespec start;
+	FILE *fp;
+	void *ptr;
+	int found = 0, deleted = 0;
+
+	if (argc != 2) {
+		fprintf( stderr, "usage: %s FILE\n", argv[0]);
+		return 1;
+	}
+
+	fp = fopen( argv[1], "rt");
+	if (!fp)
+	{
+		fprintf( stderr, "Error: cannot open file [%s]\n", argv[1]);
+		return 2;
+	}
+
+	// 입력 단어를 미리 메모리에 읽어 둠 (파일 읽기 시간 제외)
+	while (fscanf( fp, "%s", word) != EOF)
+	{
+		if (num_tokens == capacity)
+		{
+			capacity = capacity ? capacity * 2 : 1024;
+			tokens = (char **)realloc( tokens, capacity * sizeof(char *));
+		}
+		tokens[num_tokens++] = strdup( word);
+	}
+	fclose( fp);
+
+	list = createList( compare_by_word);
+	if (!list)
+	{
+		printf( "Cannot create list\n");
+		return 100;
+	}
+
+	// insert
+	clock_gettime( CLOCK_MONOTONIC, &start);
+	for (int i = 0; i < num_tokens; i++)
+	{
+		tWord *pWord = createWord( tokens[i]);
+		int ret = addNode( list, pWord, increase_freq);
+		if (ret == 0 || ret == 2) destroyWord( pWord);
+	}
+	printf( "insert\t%d tokens\t%.3f sec\n", num_tokens, elapsed( &start));
+
+	// search
+	clock_gettime( CLOCK_MONOTONIC, &start);
+	for (int i = 0; i < num_tokens; i++)
+	{
+		tWord key = { tokens[i], 0};
+		found += searchNode( list, &key, &ptr);
+	}
+	printf( "search\t%d found\t%.3f sec\n", found, elapsed( &start));
+
+	// traverse
+	clock_gettime( CLOCK_MONOTONIC, &start);
+	traverseList( list, sum_freq);
+	traverseListR( list, sum_freq);
+	printf( "traverse\t%ld\t%.3f sec\n", checksum, elapsed( &start));
+
+	// delete
+	clock_gettime( CLOCK_MONOTONIC, &start);
+	for (int i = 0; i < num_tokens; i++)
+	{
+		tWord key = { tokens[i], 0};
+		if (removeNode( list, &key, &ptr))
+		{
+			destroyWord( ptr);
+			deleted++;
+		}
+	}
+	printf( "delete\t%d words\t%.3f sec\n", deleted, elapsed( &start));
+
+	destroyList( list, destroyWord);
+	for (int i = 0; i < num_tokens; i++) free( tokens[i]);
+	free( tokens);
+
+	return 0;
+}
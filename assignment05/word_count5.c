@@ -4,6 +4,7 @@
 #include <ctype.h> // toupper
 
 #include "adt_dlist.h"
+#include "outbuf.h"
 
 #define QUIT			1
 #define FORWARD_PRINT	2
@@ -79,9 +80,13 @@ int compare_by_word( const void *n1, const void *n2)
 
 // prints contents of word structure
 // for traverseList and traverseListR functions
+// buffered (outbuf), out_flush after the traversal
 void print_word(const void *dataPtr)
 {
-	printf( "%s\t%d\n", ((tWord *)dataPtr)->word, ((tWord *)dataPtr)->freq);
+	out_str( ((tWord *)dataPtr)->word);
+	out_char( '\t');
+	out_int( ((tWord *)dataPtr)->freq);
+	out_char( '\n');
 }
 
 void increase_freq(const void *dataPtr)
@@ -151,15 +156,18 @@ int main( int argc, char **argv)
 		switch( action)
 		{
 			case QUIT:
+				statsList( stderr); // -DSTATS
 				destroyList( list, destroyWord);
 				return 0;
 			
 			case FORWARD_PRINT:
 				traverseList( list, print_word);
+				out_flush();
 				break;
 			
 			case BACKWARD_PRINT:
 				traverseListR( list, print_word);
+				out_flush();
 				break;
 			
 			case SEARCH:
@@ -167,7 +175,11 @@ int main( int argc, char **argv)
 				
 				pWord = createWord( word);
 
-				if (searchNode( list, pWord, &ptr)) print_word( ptr);
+				if (searchNode( list, pWord, &ptr))
+				{
+					print_word( ptr);
+					out_flush();
+				}
 				else fprintf( stdout, "%s not found\n", word);
 				
 				destroyWord( pWord);
@@ -4,29 +4,69 @@
 #include "bst.h"
 
 // internal functions (not mandatory)
-static int _insert(NODE *root, NODE *newPtr, int (*compare)(const void *, const void *), void (*callback)(void *));
-static NODE *_makeNode(void *dataInPtr);
-static void _destroy(NODE *root, void (*callback)(void *));
-static NODE *_delete(NODE *root, void *keyPtr, void **dataOutPtr, int (*compare)(const void *, const void *));
-static NODE *_search(NODE *root, void *keyPtr, int (*compare)(const void *, const void *));
+static int _compare(TREE *pTree, NODE *a, NODE *b);
+static void _setKey(TREE *pTree, NODE *node, void *dataPtr);
+static int _insert(TREE *pTree, NODE *root, NODE *newPtr, void (*callback)(void *));
+static NODE *_makeNode(TREE *pTree, void *dataInPtr);
+static int _destroy(NODE *root, void (*callback)(void *), NODE **pool);
+static NODE *_delete(TREE *pTree, NODE *root, NODE *keyNode, void **dataOutPtr);
+static NODE *_search(TREE *pTree, NODE *root, NODE *keyNode);
 static void _traverse(NODE *root, void (*callback)(const void *));
 static void _traverseR(NODE *root, void (*callback)(const void *));
 static void _inorder_print(NODE *root, int level, void (*callback)(const void *));
+static void _rangeTraverse(TREE *pTree, NODE *root, NODE *lo, NODE *hi, void (*callback)(const void *));
+static NODE *_split(TREE *pTree, NODE *root, NODE *keyNode, NODE **left, NODE **right);
+static NODE *_join2(NODE *left, NODE *right);
 
+// statistics (-DSTATS), see BST_Stats
+#ifdef STATS
+static struct {
+    long compare;       // compare calls
+    long abbrev;        // comparisons decided by abbreviated keys
+    long visit;         // nodes compared on the way down
+    long malloc_bytes;  // nodes allocated
+    long reuse;         // nodes taken from the pool
+} stats;
+#define STAT(x)     (x)
+#else
+#define STAT(x)     ((void)0)
+#endif
+
+// compares data of two nodes
+// abbreviated keys decide unless they are equal (compare is not called)
+static int _compare( TREE *pTree, NODE *a, NODE *b){
+    STAT(stats.visit++);
+    if (pTree->abbrev) {
+        if (a->key != b->key) return (STAT(stats.abbrev++), (a->key < b->key) ? -1 : 1);
+        if (a->key_full && b->key_full) return (STAT(stats.abbrev++), 0);
+    }
+    STAT(stats.compare++);
+    return pTree->compare(a->dataPtr, b->dataPtr);
+}
+
+// stores data and its abbreviated key into node
+static void _setKey( TREE *pTree, NODE *node, void *dataPtr){
+    node->dataPtr = dataPtr;
+    node->key = 0;
+    node->key_full = 0;
+    if (pTree->abbrev) {
+        node->key_full = pTree->abbrev(dataPtr, &node->key);
+    }
+}
 
 // used in BST_Insert
-static int _insert( NODE *root, NODE *newPtr, int (*compare)(const void *, const void *), void (*callback)(void *)){
-    int cmp = compare(newPtr->dataPtr, root->dataPtr);
+static int _insert( TREE *pTree, NODE *root, NODE *newPtr, void (*callback)(void *)){
+    int cmp = _compare(pTree, newPtr, root);
     if (cmp < 0) {
         if (root->left) {
-            return _insert(root->left, newPtr, compare, callback);
+            return _insert(pTree, root->left, newPtr, callback);
         } else {
             root->left = newPtr;
             return 1;
         }
     } else if (cmp > 0) {
         if (root->right) {
-            return _insert(root->right, newPtr, compare, callback);
+            return _insert(pTree, root->right, newPtr, callback);
         } else {
             root->right = newPtr;
             return 1;
@@ -38,36 +78,63 @@ static int _insert( NODE *root, NODE *newPtr, int (*compare)(const void *, const
 }
 
 // used in BST_Insert
-static NODE *_makeNode( void *dataInPtr){    
-    NODE *node = (NODE *)malloc(sizeof(NODE));
+// a node kept by BST_Clear is used first
+static NODE *_makeNode( TREE *pTree, void *dataInPtr){    
+    NODE *node = pTree->pool;
     if (node) {
-        node->dataPtr = dataInPtr;
+        pTree->pool = node->right;
+        STAT(stats.reuse++);
+    } else {
+        node = (NODE *)malloc(sizeof(NODE));
+        STAT(stats.malloc_bytes += sizeof(NODE));
+    }
+    if (node) {
+        _setKey(pTree, node, dataInPtr);
         node->left = NULL;
         node->right = NULL;
     }
     return node;
 }
 
-// used in BST_Destroy
-static void _destroy( NODE *root, void (*callback)(void *)) {
-    if (root) {
-        _destroy(root->left, callback);
-        _destroy(root->right, callback);
-        callback(root->dataPtr);
-        free(root);
+// used in BST_Destroy, BST_Clear, BST_DeleteRange
+// no recursion : left children are rotated up, so the node removed at the root has no left child
+// nodes are freed (pool NULL) or kept in *pool
+// return	number of nodes removed
+static int _destroy( NODE *root, void (*callback)(void *), NODE **pool) {
+    int n = 0;
+
+    while (root) {
+        if (root->left) {
+            NODE *temp = root->left;
+            root->left = temp->right;
+            temp->right = root;
+            root = temp;
+        } else {
+            NODE *temp = root->right;
+            callback(root->dataPtr);
+            if (pool) {
+                root->right = *pool;
+                *pool = root;
+            } else {
+                free(root);
+            }
+            root = temp;
+            n++;
+        }
     }
+    return n;
 }
 
 // used in BST_Delete
 // return 	pointer to root
-static NODE *_delete( NODE *root, void *keyPtr, void **dataOutPtr, int (*compare)(const void *, const void *)){
+static NODE *_delete( TREE *pTree, NODE *root, NODE *keyNode, void **dataOutPtr){
     if (!root) return NULL;
 
-    int cmp = compare(keyPtr, root->dataPtr);
+    int cmp = _compare(pTree, keyNode, root);
     if (cmp < 0) {
-        root->left = _delete(root->left, keyPtr, dataOutPtr, compare);
+        root->left = _delete(pTree, root->left, keyNode, dataOutPtr);
     } else if (cmp > 0) {
-        root->right = _delete(root->right, keyPtr, dataOutPtr, compare);
+        root->right = _delete(pTree, root->right, keyNode, dataOutPtr);
     } else {
         *dataOutPtr = root->dataPtr;
         if (!root->left) {
@@ -82,8 +149,11 @@ static NODE *_delete( NODE *root, void *keyPtr, void **dataOutPtr, int (*compare
             //우측 subtree에서 가장 작은 노드를 찾아서 삭제할 노드의 자리에 놓는다.
             NODE *minNode = root->right;
             while (minNode->left) minNode = minNode->left;
-            root->dataPtr = minNode->dataPtr;
-            root->right = _delete(root->right, minNode->dataPtr, &minNode->dataPtr, compare);
+            NODE minKey = *minNode;
+            root->dataPtr = minKey.dataPtr;
+            root->key = minKey.key;
+            root->key_full = minKey.key_full;
+            root->right = _delete(pTree, root->right, &minKey, &minKey.dataPtr);
         }
     }
     return root;
@@ -93,11 +163,11 @@ static NODE *_delete( NODE *root, void *keyPtr, void **dataOutPtr, int (*compare
 // Retrieve node containing the requested key
 // return	address of the node containing the key
 //			NULL not found
-static NODE *_search( NODE *root, void *keyPtr, int (*compare)(const void *, const void *)){
+static NODE *_search( TREE *pTree, NODE *root, NODE *keyNode){
     if (!root) return NULL;
-    int cmp = compare(keyPtr, root->dataPtr);
-    if (cmp < 0) return _search(root->left, keyPtr, compare);
-    if (cmp > 0) return _search(root->right, keyPtr, compare);
+    int cmp = _compare(pTree, keyNode, root);
+    if (cmp < 0) return _search(pTree, root->left, keyNode);
+    if (cmp > 0) return _search(pTree, root->right, keyNode);
     return root;
 }
 
@@ -130,33 +200,103 @@ static void _inorder_print( NODE *root, int level, void (*callback)(const void *
     }
 }
 
+// used in BST_RangeTraverse
+// subtrees outside [lo, hi] are not visited
+static void _rangeTraverse( TREE *pTree, NODE *root, NODE *lo, NODE *hi, void (*callback)(const void *)) {
+    while (root) {
+        int cmp_lo = _compare(pTree, lo, root);
+        int cmp_hi = _compare(pTree, hi, root);
+        if (cmp_lo < 0) _rangeTraverse(pTree, root->left, lo, hi, callback);
+        if (cmp_lo <= 0 && cmp_hi >= 0) callback(root->dataPtr);
+        if (cmp_hi <= 0) break;
+        root = root->right; // loop instead of a tail call
+    }
+}
+
+// used in BST_DeleteRange
+// splits root into nodes less than keyNode (*left) and greater than keyNode (*right)
+// goes down one path, so no recursion
+// return	node with the key (not in *left, *right)
+//			NULL not found
+static NODE *_split( TREE *pTree, NODE *root, NODE *keyNode, NODE **left, NODE **right) {
+    while (root) {
+        int cmp = _compare(pTree, keyNode, root);
+        if (cmp == 0) {
+            *left = root->left;
+            *right = root->right;
+            return root;
+        }
+        if (cmp < 0) {
+            *right = root;  // root and its right subtree are greater
+            right = &root->left;
+            root = root->left;
+        } else {
+            *left = root;
+            left = &root->right;
+            root = root->right;
+        }
+    }
+    *left = *right = NULL;
+    return NULL;
+}
+
+// used in BST_DeleteRange
+// every data of left < every data of right
+// right hangs below the largest node of left
+static NODE *_join2( NODE *left, NODE *right) {
+    NODE *last = left;
+
+    if (!left) return right;
+    while (last->right) last = last->right;
+    last->right = right;
+    return left;
+}
+
 TREE *BST_Create(int (*compare)(const void *, const void *)) {
+    return BST_CreateAbbrev(compare, NULL);
+}
+
+TREE *BST_CreateAbbrev(int (*compare)(const void *, const void *), int (*abbrev)(const void *, unsigned long long *)) {
     TREE *tree = (TREE *)malloc(sizeof(TREE));
     if (tree) {
         tree->count = 0;
         tree->root = NULL;
         tree->compare = compare;
+        tree->abbrev = abbrev;
+        tree->pool = NULL;
     }
     return tree;
 }
 
 void BST_Destroy(TREE *pTree, void (*callback)(void *)) {
     if (pTree) {
-        _destroy(pTree->root, callback);
+        _destroy(pTree->root, callback, NULL);
+        while (pTree->pool) {
+            NODE *node = pTree->pool;
+            pTree->pool = node->right;
+            free(node);
+        }
         free(pTree);
     }
 }
 
+void BST_Clear(TREE *pTree, void (*callback)(void *)) {
+    _destroy(pTree->root, callback, &pTree->pool);
+    pTree->root = NULL;
+    pTree->count = 0;
+}
+
 int BST_Insert(TREE *pTree, void *dataInPtr, void (*callback)(void *)) {
-    NODE *newNode = _makeNode(dataInPtr);
+    NODE *newNode = _makeNode(pTree, dataInPtr);
     if (!newNode) return 0;
 
     if (!pTree->root) {
         pTree->root = newNode;
     } else {
-        int result = _insert(pTree->root, newNode, pTree->compare, callback);
+        int result = _insert(pTree, pTree->root, newNode, callback);
         if (result == 2) {
-            free(newNode);
+            newNode->right = pTree->pool; // back to the pool for the next insert
+            pTree->pool = newNode;
             return 2;
         }
     }
@@ -167,7 +307,9 @@ int BST_Insert(TREE *pTree, void *dataInPtr, void (*callback)(void *)) {
 
 void *BST_Delete(TREE *pTree, void *keyPtr) {
     void *dataOutPtr = NULL;
-    pTree->root = _delete(pTree->root, keyPtr, &dataOutPtr, pTree->compare);
+    NODE keyNode;
+    _setKey(pTree, &keyNode, keyPtr);
+    pTree->root = _delete(pTree, pTree->root, &keyNode, &dataOutPtr);
     if (dataOutPtr) {
         pTree->count--;
     }
@@ -175,7 +317,9 @@ void *BST_Delete(TREE *pTree, void *keyPtr) {
 }
 
 void *BST_Search(TREE *pTree, void *keyPtr) {
-    NODE *node = _search(pTree->root, keyPtr, pTree->compare);
+    NODE keyNode;
+    _setKey(pTree, &keyNode, keyPtr);
+    NODE *node = _search(pTree, pTree->root, &keyNode);
     return node ? node->dataPtr : NULL;
 }
 
@@ -193,4 +337,48 @@ void printTree(TREE *pTree, void (*callback)(const void *)) {
 
 int BST_Count(TREE *pTree) {
     return pTree->count;
-}
\ No newline at end of file
+}
+
+void BST_RangeTraverse(TREE *pTree, void *loPtr, void *hiPtr, void (*callback)(const void *)) {
+    NODE lo, hi;
+    _setKey(pTree, &lo, loPtr);
+    _setKey(pTree, &hi, hiPtr);
+    _rangeTraverse(pTree, pTree->root, &lo, &hi, callback);
+}
+
+int BST_DeleteRange(TREE *pTree, void *loPtr, void *hiPtr, void (*callback)(void *)) {
+    NODE lo, hi, *left, *middle, *right, *found;
+    int n = 0;
+
+    _setKey(pTree, &lo, loPtr);
+    _setKey(pTree, &hi, hiPtr);
+    if (_compare(pTree, &lo, &hi) > 0) return 0;
+
+    // left < lo <= middle <= hi < right
+    found = _split(pTree, pTree->root, &lo, &left, &middle);
+    if (found) {
+        callback(found->dataPtr);
+        free(found);
+        n++;
+    }
+    found = _split(pTree, middle, &hi, &middle, &right);
+    if (found) {
+        callback(found->dataPtr);
+        free(found);
+        n++;
+    }
+    n += _destroy(middle, callback, NULL); // no recursion on a degenerate subtree
+
+    pTree->root = _join2(left, right);
+    pTree->count -= n;
+    return n;
+}
+
+void BST_Stats(FILE *fp) {
+#ifdef STATS
+    fprintf(fp, "{\"adt\": \"bst\", \"compare\": %ld, \"abbrev\": %ld, \"visit\": %ld, \"malloc_bytes\": %ld, \"reuse\": %ld}\n",
+        stats.compare, stats.abbrev, stats.visit, stats.malloc_bytes, stats.reuse);
+#else
+    (void)fp;
+#endif
+}
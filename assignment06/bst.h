@@ -1,10 +1,14 @@
 ////////////////////////////////////////////////////////////////////////////////
 // TREE type definition
+#include <stdio.h> // FILE
+
 typedef struct node
 {
 	void *dataPtr;
 	struct node	*left;
 	struct node	*right;
+	unsigned long long	key;		// abbreviated key (TREE abbrev)
+	int					key_full;	// key holds the whole key
 } NODE;
 
 typedef struct
@@ -12,6 +16,8 @@ typedef struct
 	int		count;
 	NODE	*root;
 	int		(*compare)(const void *, const void *); 
+	int		(*abbrev)(const void *, unsigned long long *); // NULL : compare only
+	NODE	*pool;	// nodes kept by BST_Clear for reuse (linked by right)
 } TREE;
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -23,10 +29,26 @@ typedef struct
 */
 TREE *BST_Create( int (*compare)(const void *, const void *));
 
+/* BST_Create with an abbreviated key cached in each node
+	abbrev(data, &key) stores a number whose order agrees with compare
+	(key1 < key2 means compare < 0), e.g. the first 8 bytes of a string packed big-endian
+	and returns 1 if the key holds the whole key (equal keys mean equal data), 0 otherwise
+	compare is called only when the abbreviated keys are equal
+	return	head node pointer
+			NULL if overflow
+*/
+TREE *BST_CreateAbbrev( int (*compare)(const void *, const void *), int (*abbrev)(const void *, unsigned long long *));
+
 /* Deletes all data in tree and recycles memory
+	no recursion : the depth of the tree does not matter
 */
 void BST_Destroy( TREE *pTree, void (*callback)(void *));
 
+/* Deletes all data in tree, keeps the nodes for the next insertions
+	(e.g. before the next input file is counted)
+*/
+void BST_Clear( TREE *pTree, void (*callback)(void *));
+
 /* Inserts new data into the tree
 	callback은 이미 트리에 존재하는 데이터를 발견했을 때 호출하는 함수
 	return	0 overflow
@@ -55,6 +77,18 @@ void BST_Traverse( TREE *pTree, void (*callback)(const void *));
 */
 void BST_TraverseR( TREE *pTree, void (*callback)(const void *));
 
+/* inorder traversal of the data from loPtr to hiPtr (both included)
+	only the O(log n + k) nodes on the way are visited (height + k for an unbalanced tree)
+*/
+void BST_RangeTraverse( TREE *pTree, void *loPtr, void *hiPtr, void (*callback)(const void *));
+
+/* Deletes all data from loPtr to hiPtr (both included)
+	the tree is split at both keys and the two outer parts are joined again
+	callback frees the deleted data
+	return	number of deleted data
+*/
+int BST_DeleteRange( TREE *pTree, void *loPtr, void *hiPtr, void (*callback)(void *));
+
 /* Print tree using right-to-left inorder traversal with level
 */
 void printTree( TREE *pTree, void (*callback)(const void *));
@@ -63,3 +97,9 @@ void printTree( TREE *pTree, void (*callback)(const void *));
 */
 int BST_Count( TREE *pTree);
 
+/* prints the counters of tree operations as one line of JSON
+	(compare calls, comparisons decided by abbreviated keys, nodes compared on the way down,
+	bytes allocated for nodes, nodes reused from the pool)
+	the counters are compiled in with -DSTATS (make CFLAGS=-DSTATS); otherwise nothing is printed
+*/
+void BST_Stats( FILE *fp);
@@ -1,9 +1,11 @@
 #include <stdio.h>
 #include <stdlib.h> // malloc
-#include <string.h> // strdup, strcmp
+#include <string.h> // strcmp
 #include <ctype.h> // toupper
 
 #include "bst.h"
+#include "outbuf.h"
+#include "intern.h"
 
 #define QUIT			1
 #define FORWARD_PRINT	2
@@ -16,7 +18,7 @@
 // User structure type definition
 // 단어 구조체
 typedef struct {
-	char	*word;		// 단어
+	STR		word;		// 단어 (intern pool handle)
 	int		freq;		// 빈도
 } tWord;
 
@@ -24,21 +26,19 @@ typedef struct {
 // 단어 구조체를 위한 메모리를 할당하고 word, freq 초기화
 // return	할당된 단어 구조체에 대한 pointer
 //			NULL if overflow
-tWord *createWord( char *word){
+tWord *createWord( STR word){
     tWord *newWord = (tWord *)malloc(sizeof(tWord));
     if (!newWord) return NULL;
-    newWord->word = strdup(word);
+    newWord->word = word;
     newWord->freq = 1;
     return newWord;
 }
 
 
-// 단어 구조체에 할당된 메모리를 해제
+// 단어 구조체에 할당된 메모리를 해제 (the word stays in the intern pool)
 // for destroyList function
 void destroyWord( void *pNode){
-    tWord *wordNode = (tWord *)pNode;
-    if (wordNode->word) free(wordNode->word); 
-    free(wordNode);
+    free(pNode);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -71,26 +71,55 @@ int get_action()
 // compares two words in word structures
 // for BST_Create function
 // 정렬 기준 : 단어
+// equal words have equal handles, strcmp only orders different words
 int compare_by_word( const void *n1, const void *n2)
 {
 	tWord *p1 = (tWord *)n1;
 	tWord *p2 = (tWord *)n2;
 	
-	return strcmp( p1->word, p2->word);
+	if (p1->word == p2->word) return 0;
+	return strcmp( intern_str( p1->word), intern_str( p2->word));
+}
+
+// abbreviated key of a word : first 8 bytes packed big-endian (the same order as strcmp)
+// for BST_CreateAbbrev function
+// return	1 if the word is shorter than 8 bytes (key holds the whole word)
+//			0 otherwise
+int abbrev_word( const void *n, unsigned long long *key)
+{
+	const unsigned char *p = (const unsigned char *)intern_str( ((tWord *)n)->word);
+	unsigned long long k = 0;
+	int len = 0;
+
+	for (int i = 0; i < 8; i++)
+	{
+		k <<= 8;
+		if (len == i && p[i] != '\0')
+		{
+			k |= p[i];
+			len++;
+		}
+	}
+	*key = k;
+	return len < 8;
 }
 
 // prints contents of word structure
 // for BST_Traverse and BST_wTraverseR functions
+// buffered (outbuf), out_flush after the traversal
 void print_word(const void *dataPtr)
 {
-	printf( "%s\t%d\n", ((tWord *)dataPtr)->word, ((tWord *)dataPtr)->freq);
+	out_str( intern_str( ((tWord *)dataPtr)->word));
+	out_char( '\t');
+	out_int( ((tWord *)dataPtr)->freq);
+	out_char( '\n');
 }
 
 // prints word of word structure
 // for printTree function
 void print_word_only(const void *dataPtr)
 {
-	printf( "%s\n", ((tWord *)dataPtr)->word);
+	printf( "%s\n", intern_str( ((tWord *)dataPtr)->word));
 }
 
 void increase_freq(void *dataPtr)
@@ -111,7 +140,8 @@ int main( int argc, char **argv)
 	TREE *tree;
 	
 	char word[100];
-	tWord *pWord;
+	tWord *pWord, key = { 0, 0};
+	int num_interned;
 	int ret;
 	FILE *fp;
 	
@@ -128,7 +158,7 @@ int main( int argc, char **argv)
 	}
 	
 	// creates an empty tree
-	tree = BST_Create(compare_by_word);
+	tree = BST_CreateAbbrev(compare_by_word, abbrev_word);
 	if (!tree)
 	{
 		printf( "Cannot create a tree\n");
@@ -137,13 +167,24 @@ int main( int argc, char **argv)
 	
 	while(fscanf( fp, "%s", word) != EOF)
 	{
-		pWord = createWord( word);
+		// 이미 있는 단어는 메모리 할당 없이 빈도만 증가
+		// a word new to the pool is not in the tree (no search)
+		num_interned = intern_count();
+		key.word = intern( word);
 		
-		ret = BST_Insert( tree, pWord, increase_freq);
+		if (key.word && intern_count() == num_interned && (pWord = BST_Search( tree, &key)) != NULL)
+		{
+			pWord->freq++;
+			continue;
+		}
+		
+		pWord = key.word ? createWord( key.word) : NULL;
+		
+		ret = pWord ? BST_Insert( tree, pWord, increase_freq) : 0;
 		
 		if (ret == 0 || ret == 2) // failure or duplicated
 		{
-			destroyWord( pWord);
+			free( pWord);
 		}
 	}
 	
@@ -159,15 +200,19 @@ int main( int argc, char **argv)
 		switch( action)
 		{
 			case QUIT:
+				BST_Stats( stderr); // -DSTATS
 				BST_Destroy( tree, destroyWord);
+				intern_clear();
 				return 0;
 			
 			case FORWARD_PRINT:
 				BST_Traverse( tree, print_word);
+				out_flush();
 				break;
 			
 			case BACKWARD_PRINT:
 				BST_TraverseR( tree, print_word);
+				out_flush();
 				break;
 			
 			case TREE_PRINT:
@@ -177,27 +222,27 @@ int main( int argc, char **argv)
 			case SEARCH:
 				input_word(word);
 				
-				pWord = createWord( word);
+				key.word = intern_find( word); // 0 : never counted
 
-				if ((ptr = BST_Search( tree, pWord)) != NULL) print_word( ptr);
+				if (key.word && (ptr = BST_Search( tree, &key)) != NULL)
+				{
+					print_word( ptr);
+					out_flush();
+				}
 				else fprintf( stdout, "%s not found\n", word);
-				
-				destroyWord( pWord);
 				break;
 				
 			case DELETE:
 				input_word(word);
 				
-				pWord = createWord( word);
+				key.word = intern_find( word);
 
-				if ((ptr = BST_Delete( tree, pWord)) != NULL)
+				if (key.word && (ptr = BST_Delete( tree, &key)) != NULL)
 				{
-					fprintf( stdout, "(%s, %d) deleted\n", ((tWord *)ptr)->word, ((tWord *)ptr)->freq);
+					fprintf( stdout, "(%s, %d) deleted\n", intern_str( ((tWord *)ptr)->word), ((tWord *)ptr)->freq);
 					destroyWord( ptr);
 				}
 				else fprintf( stdout, "%s not found\n", word);
-				
-				destroyWord( pWord);
 				break;
 			
 			case COUNT:
@@ -5,6 +5,21 @@
 static void _reheapUp(HEAP *heap, int index);
 static void _reheapDown(HEAP *heap, int index);
 
+// statistics (-DSTATS), see heap_Stats
+#ifdef STATS
+static struct {
+    long compare;       // compare calls
+    long swap;          // exchanges by reheap up and down
+    long realloc;       // growths of the heap array
+    long malloc_bytes;  // heap arrays allocated (growth included)
+} stats;
+#define STAT(x)     (x)
+#else
+#define STAT(x)     ((void)0)
+#endif
+
+#define COMPARE(heap, a, b) (STAT(stats.compare++), (heap)->compare((a), (b)))
+
 // Reestablishes heap by moving data in child up to correct location heap array for heap_Insert function
 static void _reheapUp(HEAP *heap, int index) {
     int parent;
@@ -12,7 +27,8 @@ static void _reheapUp(HEAP *heap, int index) {
 
     if (index) {
         parent = (index - 1) / 2;
-        if (heap->compare(heap->heapArr[index], heap->heapArr[parent]) > 0) {
+        if (COMPARE(heap, heap->heapArr[index], heap->heapArr[parent]) > 0) {
+            STAT(stats.swap++);
             temp = heap->heapArr[index];
             heap->heapArr[index] = heap->heapArr[parent];
             heap->heapArr[parent] = temp;
@@ -30,13 +46,14 @@ static void _reheapDown(HEAP *heap, int index) {
     rightChild = 2 * index + 2;
 
     if (leftChild < heap->last) {
-        if (rightChild < heap->last && heap->compare(heap->heapArr[rightChild], heap->heapArr[leftChild]) > 0) {
+        if (rightChild < heap->last && COMPARE(heap, heap->heapArr[rightChild], heap->heapArr[leftChild]) > 0) {
             largerChild = rightChild;
         } else {
             largerChild = leftChild;
         }
 
-        if (heap->compare(heap->heapArr[largerChild], heap->heapArr[index]) > 0) {
+        if (COMPARE(heap, heap->heapArr[largerChild], heap->heapArr[index]) > 0) {
+            STAT(stats.swap++);
             temp = heap->heapArr[index];
             heap->heapArr[index] = heap->heapArr[largerChild];
             heap->heapArr[largerChild] = temp;
@@ -58,6 +75,7 @@ HEAP *heap_Create(int (*compare)(const void *arg1, const void *arg2)) {
         free(heap);
         return NULL;
     }
+    STAT(stats.malloc_bytes += heap->capacity * sizeof(void *));
 
     return heap;
 }
@@ -81,6 +99,8 @@ int heap_Insert(HEAP *heap, void *dataPtr) {
         temp = (void **)realloc(heap->heapArr, 2 * heap->capacity * sizeof(void *));
         if (!temp) return 0;
 
+        STAT(stats.realloc++);
+        STAT(stats.malloc_bytes += heap->capacity * sizeof(void *));
         heap->heapArr = temp;
         heap->capacity *= 2;
     }
@@ -97,9 +117,9 @@ int heap_Delete(HEAP *heap, void **dataOutPtr) {
 
     *dataOutPtr = heap->heapArr[0];
     
+    (heap->last)--;
     heap->heapArr[0] = heap->heapArr[heap->last];
     _reheapDown(heap, 0);
-    (heap->last)--;
     return 1;
 }
 
@@ -114,4 +134,14 @@ void heap_Print(HEAP *heap, void (*print_func)(const void *data)) {
         print_func(heap->heapArr[i]);
     }
     printf("\n");
-}
\ No newline at end of file
+}
+
+// Print the counters as one line of JSON (-DSTATS)
+void heap_Stats(FILE *fp) {
+#ifdef STATS
+    fprintf(fp, "{\"adt\": \"heap\", \"compare\": %ld, \"swap\": %ld, \"realloc\": %ld, \"malloc_bytes\": %ld}\n",
+        stats.compare, stats.swap, stats.realloc, stats.malloc_bytes);
+#else
+    (void)fp;
+#endif
+}
@@ -1,3 +1,5 @@
+#include <stdio.h> // FILE
+
 typedef struct
 {
 	int	last;
@@ -34,3 +36,8 @@ int heap_Empty(  HEAP *heap);
 /* Print heap array */
 void heap_Print( HEAP *heap, void (*print_func) (const void *data));
 
+/* Print the counters of heap operations as one line of JSON
+(compare calls, exchanges, growths of the array, bytes allocated for the array)
+the counters are compiled in with -DSTATS (make CFLAGS=-DSTATS); otherwise nothing is printed
+*/
+void heap_Stats( FILE *fp);
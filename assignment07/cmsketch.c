@@ -0,0 +1,99 @@
+#include <stdlib.h> // malloc, calloc, free
+#include <math.h> // ceil, log, exp
+
+#include "cmsketch.h"
+
+static unsigned long long _hash(const char *word);
+static unsigned _row(CMSKETCH *cms, unsigned long long h, int i);
+
+// 64-bit FNV-1a
+static unsigned long long _hash(const char *word) {
+    unsigned long long h = 14695981039346656037ULL;
+
+    while (*word) {
+        h ^= (unsigned char)*word++;
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+// column of row i : h mixed with a seed of the row (murmur3 finalizer)
+// independent columns per row; h1 + i * h2 would give only width^2 column patterns,
+// so a rare word could share every counter of a frequent one
+static unsigned _row(CMSKETCH *cms, unsigned long long h, int i) {
+    h += (i + 1) * 0x9e3779b97f4a7c15ULL;
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return (unsigned)(h & (cms->width - 1));
+}
+
+// Allocates a sketch, NULL if overflow
+CMSKETCH *cms_Create(double epsilon, double delta) {
+    CMSKETCH *cms;
+    int width = 1, depth;
+
+    if (epsilon <= 0 || delta <= 0 || delta >= 1) return NULL;
+    while (width < exp(1.0) / epsilon && width < (1 << 30)) width *= 2;
+    depth = (int)ceil(log(1 / delta));
+    if (depth < 1) depth = 1;
+    if (depth > CMS_MAX_DEPTH) depth = CMS_MAX_DEPTH;
+
+    cms = (CMSKETCH *)malloc(sizeof(CMSKETCH));
+    if (!cms) return NULL;
+
+    cms->width = width;
+    cms->depth = depth;
+    cms->total = 0;
+    cms->count = (unsigned *)calloc((size_t)width * depth, sizeof(unsigned));
+    if (!cms->count) {
+        free(cms);
+        return NULL;
+    }
+    return cms;
+}
+
+// Free memory for sketch
+void cms_Destroy(CMSKETCH *cms) {
+    if (cms) {
+        free(cms->count);
+        free(cms);
+    }
+}
+
+// Counts word once (conservative update), returns new estimate
+unsigned cms_Add(CMSKETCH *cms, const char *word) {
+    unsigned long long h = _hash(word);
+    unsigned *cell[CMS_MAX_DEPTH];
+    unsigned min = ~0U;
+
+    for (int i = 0; i < cms->depth; i++) {
+        cell[i] = &cms->count[(size_t)i * cms->width + _row(cms, h, i)];
+        if (*cell[i] < min) min = *cell[i];
+    }
+    // counters above min + 1 already count other words enough
+    for (int i = 0; i < cms->depth; i++) {
+        if (*cell[i] == min) (*cell[i])++;
+    }
+    cms->total++;
+    return min + 1;
+}
+
+// Returns estimate of word
+unsigned cms_Estimate(CMSKETCH *cms, const char *word) {
+    unsigned long long h = _hash(word);
+    unsigned min = ~0U;
+
+    for (int i = 0; i < cms->depth; i++) {
+        unsigned c = cms->count[(size_t)i * cms->width + _row(cms, h, i)];
+        if (c < min) min = c;
+    }
+    return min;
+}
+
+// Returns error bound epsilon * total (epsilon = e / width)
+long cms_Error(CMSKETCH *cms) {
+    return (long)ceil(exp(1.0) / cms->width * cms->total);
+}
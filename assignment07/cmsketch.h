@@ -0,0 +1,40 @@
+////////////////////////////////////////////////////////////////////////////////
+// Count-Min sketch (Cormode and Muthukrishnan) with conservative update
+// approximate frequencies of words in fixed memory (depth x width counters)
+// estimate >= true frequency, and estimate <= true frequency + epsilon * total
+// with probability 1 - delta
+
+#define CMS_MAX_DEPTH	32 // delta >= e^-32
+
+typedef struct
+{
+	int			width;	// counters per row (power of 2)
+	int			depth;	// rows (hash functions)
+	long		total;	// number of added words
+	unsigned	*count;	// depth * width counters
+} CMSKETCH;
+
+/* Allocates a sketch for the error bound epsilon * total with probability 1 - delta
+	width = e / epsilon (rounded up to a power of 2), depth = ln(1 / delta)
+	return	sketch
+			NULL if overflow
+*/
+CMSKETCH *cms_Create( double epsilon, double delta);
+
+/* Free memory for sketch
+*/
+void cms_Destroy( CMSKETCH *cms);
+
+/* Counts word once
+	conservative update : only the counters equal to the minimum are increased
+	return	new estimate of word
+*/
+unsigned cms_Add( CMSKETCH *cms, const char *word);
+
+/* return	estimate of word (never less than its frequency)
+*/
+unsigned cms_Estimate( CMSKETCH *cms, const char *word);
+
+/* return	error bound : estimate - true frequency <= bound with probability 1 - delta
+*/
+long cms_Error( CMSKETCH *cms);
@@ -0,0 +1,119 @@
+#include <stdio.h>
+#include <stdlib.h> // malloc, rand, free, atoi
+#include <time.h> // clock_gettime
+
+#include "adt_heap.h"
+#include "heap_tmpl.h"
+
+// generic heap (adt_heap.c : void *, compare through a function pointer, malloc per element)
+// vs type-specialised heap (heap_tmpl.h : int stored inline, inlined compare)
+// on the run_int_heap workload : insert random numbers, then delete all
+// usage: heap_bench [number of elements]
+
+/* user-defined compare function (run_int_heap.c) */
+int compare(const void *arg1, const void *arg2)
+{
+	int *a1 = (int *)arg1;
+	int *a2 = (int *)arg2;
+
+	return *a1 - *a2;
+}
+
+static inline int compare_int( const int *a1, const int *a2)
+{
+	return *a1 - *a2;
+}
+
+HEAP_DEFINE( int, compare_int)
+
+// 경과 시간 (초)
+static double elapsed( struct timespec *start)
+{
+	struct timespec now;
+	clock_gettime( CLOCK_MONOTONIC, &now);
+	return (now.tv_sec - start->tv_sec) + (now.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int main( int argc, char **argv)
+{
+	int num_elem = 1000000;
+	int *input, *out_generic, *out_typed;
+	struct timespec start;
+	double t_insert, t_delete;
+	HEAP *heap;
+	HEAP(int) *iheap;
+	void *dataPtr;
+	int n;
+
+	if (argc == 2) num_elem = atoi( argv[1]);
+	if (num_elem <= 0)
+	{
+		fprintf( stderr, "usage: %s [number of elements]\n", argv[0]);
+		return 1;
+	}
+
+	input = (int *)malloc( num_elem * sizeof(int));
+	out_generic = (int *)malloc( num_elem * sizeof(int));
+	out_typed = (int *)malloc( num_elem * sizeof(int));
+	if (!input || !out_generic || !out_typed) return 100;
+
+	srand( 1);
+	for (int i = 0; i < num_elem; i++)
+		input[i] = rand() % (num_elem * 3) + 1; // 1 ~ num_elem*3 random number
+
+	printf( "%d elements\tinsert\t\tdelete\n", num_elem);
+
+	// type-specialised (first : the elements freed by the generic run would slow down its realloc)
+	iheap = heap_Create_int();
+	if (!iheap) return 100;
+
+	clock_gettime( CLOCK_MONOTONIC, &start);
+	for (int i = 0; i < num_elem; i++)
+		if (heap_Insert_int( iheap, input[i]) == 0) break;
+	t_insert = elapsed( &start);
+
+	clock_gettime( CLOCK_MONOTONIC, &start);
+	for (n = 0; heap_Delete_int( iheap, &out_typed[n]); n++)
+		;
+	t_delete = elapsed( &start);
+	heap_Destroy_int( iheap, NULL);
+	printf( "HEAP(int)\t%.3f sec\t%.3f sec\n", t_insert, t_delete);
+
+	// generic
+	heap = heap_Create( compare);
+	if (!heap) return 100;
+
+	clock_gettime( CLOCK_MONOTONIC, &start);
+	for (int i = 0; i < num_elem; i++)
+	{
+		int *newdata = (int *)malloc( sizeof(int));
+		*newdata = input[i];
+		if (heap_Insert( heap, newdata) == 0) break;
+	}
+	t_insert = elapsed( &start);
+
+	clock_gettime( CLOCK_MONOTONIC, &start);
+	for (n = 0; heap_Delete( heap, &dataPtr); n++)
+	{
+		out_generic[n] = *(int *)dataPtr;
+		free( dataPtr);
+	}
+	t_delete = elapsed( &start);
+	heap_Destroy( heap, free);
+	printf( "generic\t\t%.3f sec\t%.3f sec\n", t_insert, t_delete);
+
+	for (int i = 0; i < num_elem; i++)
+	{
+		if (out_generic[i] != out_typed[i])
+		{
+			fprintf( stderr, "Error: different order at %d\n", i);
+			break;
+		}
+	}
+
+	free( input);
+	free( out_generic);
+	free( out_typed);
+	return 0;
+}
@@ -0,0 +1,108 @@
+////////////////////////////////////////////////////////////////////////////////
+// type-specialised heap (macro template)
+// HEAP_DEFINE( TYPE, CMP) generates a max heap storing TYPE values inline (no void *, no
+// malloc per element); CMP( const TYPE *a, const TYPE *b) is a function or macro known at
+// compile time, so it can be inlined (the same convention as compare of adt_heap.h)
+//
+//	HEAP_DEFINE( int, compare_int)
+//	HEAP(int) *heap = heap_Create_int();
+//	heap_Insert_int( heap, 7);
+//
+// TYPE must be a single identifier (use typedef for struct or pointer types)
+
+#include <stdlib.h> // malloc, realloc, free
+
+#define HEAP(TYPE)	HEAP_##TYPE
+
+#define HEAP_DEFINE(TYPE, CMP)																\
+typedef struct																				\
+{																							\
+	int		last;																			\
+	int		capacity;																		\
+	TYPE	*heapArr;																		\
+} HEAP_##TYPE;																				\
+																							\
+/* Allocates memory for heap (initial capacity 10)											\
+	return	NULL if overflow																\
+*/																							\
+static inline HEAP_##TYPE *heap_Create_##TYPE( void)										\
+{																							\
+	HEAP_##TYPE *heap = (HEAP_##TYPE *)malloc( sizeof(HEAP_##TYPE));						\
+	if (!heap) return NULL;																	\
+	heap->last = 0;																			\
+	heap->capacity = 10;																	\
+	heap->heapArr = (TYPE *)malloc( heap->capacity * sizeof(TYPE));							\
+	if (!heap->heapArr)																		\
+	{																						\
+		free( heap);																		\
+		return NULL;																		\
+	}																						\
+	return heap;																			\
+}																							\
+																							\
+/* Free memory for heap (remove_data may be NULL)											\
+*/																							\
+static inline void heap_Destroy_##TYPE( HEAP_##TYPE *heap, void (*remove_data)(TYPE *))	\
+{																							\
+	if (!heap) return;																		\
+	if (remove_data)																		\
+		for (int i = 0; i < heap->last; i++) remove_data( &heap->heapArr[i]);				\
+	free( heap->heapArr);																	\
+	free( heap);																			\
+}																							\
+																							\
+/* Inserts data into heap																	\
+	return	1 if successful; 0 if overflow													\
+*/																							\
+static inline int heap_Insert_##TYPE( HEAP_##TYPE *heap, TYPE data)						\
+{																							\
+	int index, parent;																		\
+	if (heap->last == heap->capacity)														\
+	{																						\
+		TYPE *temp = (TYPE *)realloc( heap->heapArr, 2 * heap->capacity * sizeof(TYPE));	\
+		if (!temp) return 0;																\
+		heap->heapArr = temp;																\
+		heap->capacity *= 2;																\
+	}																						\
+	/* reheap up : parents move down, data is stored once */								\
+	for (index = heap->last; index > 0; index = parent)										\
+	{																						\
+		parent = (index - 1) / 2;															\
+		if (CMP( &data, &heap->heapArr[parent]) <= 0) break;								\
+		heap->heapArr[index] = heap->heapArr[parent];										\
+	}																						\
+	heap->heapArr[index] = data;															\
+	heap->last++;																			\
+	return 1;																				\
+}																							\
+																							\
+/* Deletes root of heap and passes data back to caller										\
+	return	1 if successful; 0 if heap empty												\
+*/																							\
+static inline int heap_Delete_##TYPE( HEAP_##TYPE *heap, TYPE *dataOutPtr)					\
+{																							\
+	int index = 0, child;																	\
+	TYPE data;																				\
+	if (heap->last == 0) return 0;															\
+	*dataOutPtr = heap->heapArr[0];															\
+	heap->last--;																			\
+	data = heap->heapArr[heap->last];														\
+	/* reheap down : larger children move up */												\
+	while ((child = 2 * index + 1) < heap->last)											\
+	{																						\
+		if (child + 1 < heap->last && CMP( &heap->heapArr[child + 1], &heap->heapArr[child]) > 0)	\
+			child++;																		\
+		if (CMP( &heap->heapArr[child], &data) <= 0) break;									\
+		heap->heapArr[index] = heap->heapArr[child];										\
+		index = child;																		\
+	}																						\
+	heap->heapArr[index] = data;															\
+	return 1;																				\
+}																							\
+																							\
+/* return	1 if the heap is empty; 0 if not												\
+*/																							\
+static inline int heap_Empty_##TYPE( HEAP_##TYPE *heap)									\
+{																							\
+	return heap->last == 0;																	\
+}
@@ -72,6 +72,7 @@ int main(void)
  	}
 	printf("\n");
 	
+	heap_Stats(stderr); // -DSTATS
 	heap_Destroy(heap, remove_data);
 
 	return 0;
@@ -116,6 +116,7 @@ int main( int argc, char **argv)
  	}
 	printf("\n");
 	
+	heap_Stats(stderr); // -DSTATS
 	heap_Destroy(heap, destroyWord);
 	
 	return 0;
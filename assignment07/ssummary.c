@@ -0,0 +1,176 @@
+#include <stdlib.h> // malloc, calloc, realloc, free
+#include <string.h> // strlen, memcpy, strcmp
+
+#include "ssummary.h"
+
+static unsigned _hash(const char *word);
+static SSCOUNTER **_find(SSUMMARY *ss, const char *word);
+static void _detach(SSUMMARY *ss, SSCOUNTER *counter);
+static void _attach(SSUMMARY *ss, SSCOUNTER *counter, SSBUCKET *prev, long count);
+
+// FNV-1a
+static unsigned _hash(const char *word) {
+    unsigned h = 2166136261U;
+    while (*word) {
+        h ^= (unsigned char)*word++;
+        h *= 16777619U;
+    }
+    return h;
+}
+
+// return address of the link to the counter of word (the link is NULL if not found)
+static SSCOUNTER **_find(SSUMMARY *ss, const char *word) {
+    SSCOUNTER **link = &ss->table[_hash(word) & (ss->size - 1)];
+    while (*link && strcmp((*link)->word, word) != 0) link = &(*link)->chain;
+    return link;
+}
+
+// takes counter out of its bucket, an empty bucket goes to the free list
+static void _detach(SSUMMARY *ss, SSCOUNTER *counter) {
+    SSBUCKET *bucket = counter->bucket;
+
+    if (counter->prev) counter->prev->next = counter->next;
+    else bucket->first = counter->next;
+    if (counter->next) counter->next->prev = counter->prev;
+
+    if (!bucket->first) {
+        if (bucket->prev) bucket->prev->next = bucket->next;
+        else ss->min = bucket->next;
+        if (bucket->next) bucket->next->prev = bucket->prev;
+        else ss->max = bucket->prev;
+        bucket->next = ss->free;
+        ss->free = bucket;
+    }
+}
+
+// puts counter into the bucket of count right after prev (NULL : before min)
+// the bucket is created if prev->next (or min) has another count
+static void _attach(SSUMMARY *ss, SSCOUNTER *counter, SSBUCKET *prev, long count) {
+    SSBUCKET *next = prev ? prev->next : ss->min;
+    SSBUCKET *bucket;
+
+    if (next && next->count == count) bucket = next;
+    else {
+        bucket = ss->free; // at most k buckets are in use
+        ss->free = bucket->next;
+        bucket->count = count;
+        bucket->first = NULL;
+        bucket->prev = prev;
+        bucket->next = next;
+        if (prev) prev->next = bucket;
+        else ss->min = bucket;
+        if (next) next->prev = bucket;
+        else ss->max = bucket;
+    }
+
+    counter->bucket = bucket;
+    counter->prev = NULL;
+    counter->next = bucket->first;
+    if (bucket->first) bucket->first->prev = counter;
+    bucket->first = counter;
+}
+
+// Allocates a summary of k counters, NULL if overflow
+SSUMMARY *ss_Create(int k) {
+    SSUMMARY *ss;
+
+    if (k < 1) return NULL;
+    ss = (SSUMMARY *)malloc(sizeof(SSUMMARY));
+    if (!ss) return NULL;
+
+    ss->k = k;
+    ss->num = 0;
+    ss->total = 0;
+    ss->min = ss->max = NULL;
+    for (ss->size = 1; ss->size < 2 * k; ss->size *= 2)
+        ;
+    ss->counter = (SSCOUNTER *)calloc(k, sizeof(SSCOUNTER));
+    ss->bucket = (SSBUCKET *)malloc(k * sizeof(SSBUCKET));
+    ss->table = (SSCOUNTER **)calloc(ss->size, sizeof(SSCOUNTER *));
+    if (!ss->counter || !ss->bucket || !ss->table) {
+        free(ss->counter);
+        free(ss->bucket);
+        free(ss->table);
+        free(ss);
+        return NULL;
+    }
+
+    ss->free = NULL;
+    for (int i = k - 1; i >= 0; i--) {
+        ss->bucket[i].next = ss->free;
+        ss->free = &ss->bucket[i];
+    }
+    return ss;
+}
+
+// Free memory for summary
+void ss_Destroy(SSUMMARY *ss) {
+    if (ss) {
+        for (int i = 0; i < ss->num; i++) free(ss->counter[i].word);
+        free(ss->counter);
+        free(ss->bucket);
+        free(ss->table);
+        free(ss);
+    }
+}
+
+// Counts word once, returns count of word (0 if overflow)
+long ss_Add(SSUMMARY *ss, const char *word) {
+    SSCOUNTER **link = _find(ss, word);
+    SSCOUNTER *counter = *link;
+    SSBUCKET *prev;
+    long count;
+    int len;
+
+    if (counter) { // to the bucket of count + 1
+        prev = counter->bucket;
+        count = prev->count + 1;
+        if (!counter->prev && !counter->next) prev = prev->prev; // its bucket goes away
+        _detach(ss, counter);
+        _attach(ss, counter, prev, count);
+        ss->total++;
+        return count;
+    }
+
+    // a free counter (calloc : no word yet), or a counter of the smallest count
+    counter = (ss->num < ss->k) ? &ss->counter[ss->num] : ss->min->first;
+    len = (int)strlen(word) + 1;
+    if (len > counter->size) { // the word buffer only grows
+        char *buf = (char *)realloc(counter->word, len);
+        if (!buf) return 0;
+        counter->word = buf;
+        counter->size = len;
+    }
+
+    if (ss->num < ss->k) {
+        ss->num++;
+        counter->error = 0;
+        prev = NULL;
+    } else { // the word of the smallest count is replaced
+        *_find(ss, counter->word) = counter->chain;
+        counter->error = ss->min->count;
+        prev = counter->next ? ss->min : NULL; // counter is first of min, the bucket goes away if alone
+        _detach(ss, counter);
+        link = _find(ss, word); // the chain may have changed
+    }
+    count = counter->error + 1;
+
+    memcpy(counter->word, word, len);
+    counter->chain = NULL;
+    *link = counter;
+    _attach(ss, counter, prev, count);
+    ss->total++;
+    return count;
+}
+
+// Monitored words in decreasing order of count, returns number of counters in list
+int ss_List(SSUMMARY *ss, SSCOUNTER *list[], int n) {
+    int num = 0;
+
+    for (SSBUCKET *bucket = ss->max; bucket && num < n; bucket = bucket->prev) {
+        for (SSCOUNTER *counter = bucket->first; counter && num < n; counter = counter->next) {
+            list[num++] = counter;
+        }
+    }
+    return num;
+}
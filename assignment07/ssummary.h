@@ -0,0 +1,66 @@
+////////////////////////////////////////////////////////////////////////////////
+// Space-Saving (Metwally, Agrawal and El Abbadi) : top-K words of a stream
+// k counters in a stream-summary : buckets of equal counts in a list by count
+// O(1) per word (hash table + moving a counter to the next bucket), no allocation after ss_Create
+// count - error <= frequency <= count for a monitored word,
+// and every word of frequency > total / k is monitored
+
+typedef struct sscounter
+{
+	char				*word;
+	int					size;		// bytes of word buffer (reused when the counter is replaced)
+	long				error;		// overestimation bound (count of the replaced word)
+	struct ssbucket		*bucket;	// count of the counter
+	struct sscounter	*prev;		// counters of the same bucket
+	struct sscounter	*next;
+	struct sscounter	*chain;		// hash chain
+} SSCOUNTER;
+
+typedef struct ssbucket
+{
+	long				count;
+	SSCOUNTER			*first;		// counters of count
+	struct ssbucket		*prev;		// smaller count
+	struct ssbucket		*next;		// larger count
+} SSBUCKET;
+
+typedef struct
+{
+	int			k;			// number of counters
+	int			num;		// counters in use
+	long		total;		// number of added words
+	SSBUCKET	*min;		// bucket of the smallest count
+	SSBUCKET	*max;		// bucket of the largest count
+	SSBUCKET	*free;		// unused buckets
+	SSCOUNTER	*counter;	// k counters
+	SSBUCKET	*bucket;	// k buckets (at most k counts)
+	int			size;		// hash buckets (power of 2)
+	SSCOUNTER	**table;	// hash table of monitored words
+} SSUMMARY;
+
+/* Allocates a summary of k counters
+	return	summary
+			NULL if overflow
+*/
+SSUMMARY *ss_Create( int k);
+
+/* Free memory for summary
+*/
+void ss_Destroy( SSUMMARY *ss);
+
+/* Counts word once
+	an unmonitored word replaces a word of the smallest count when the counters are full
+	return	count of word (frequency + error)
+			0 if overflow
+*/
+long ss_Add( SSUMMARY *ss, const char *word);
+
+/* Monitored words in decreasing order of count, at any moment of the stream
+	list has room for n counters
+	return	number of counters in list
+*/
+int ss_List( SSUMMARY *ss, SSCOUNTER *list[], int n);
+
+/* return	count of a monitored counter
+*/
+#define ss_Count( counter)	((counter)->bucket->count)
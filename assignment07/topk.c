@@ -0,0 +1,151 @@
+#include <stdlib.h> // malloc, calloc, free, qsort
+#include <string.h> // strdup, strcmp
+
+#include "topk.h"
+
+static unsigned _hash(const char *word);
+static tEntry **_find(TOPK *topk, const char *word);
+static tEntry *_smallest(TOPK *topk);
+
+// compare for the heap : smaller heap_count is larger (min-heap on adt_heap)
+static int compare_by_heap_count(const void *n1, const void *n2) {
+    long c1 = ((tEntry *)n1)->heap_count, c2 = ((tEntry *)n2)->heap_count;
+    return (c1 < c2) - (c1 > c2);
+}
+
+// decreasing count, then word
+static int compare_by_count(const void *n1, const void *n2) {
+    const tEntry *e1 = *(const tEntry **)n1, *e2 = *(const tEntry **)n2;
+    if (e1->count != e2->count) return (e1->count < e2->count) ? 1 : -1;
+    return strcmp(e1->word, e2->word);
+}
+
+// FNV-1a
+static unsigned _hash(const char *word) {
+    unsigned h = 2166136261U;
+    while (*word) {
+        h ^= (unsigned char)*word++;
+        h *= 16777619U;
+    }
+    return h;
+}
+
+// return address of the link to the entry of word (the link is NULL if not found)
+static tEntry **_find(TOPK *topk, const char *word) {
+    tEntry **link = &topk->table[_hash(word) & (topk->size - 1)];
+    while (*link && strcmp((*link)->word, word) != 0) link = &(*link)->next;
+    return link;
+}
+
+// takes the candidate of the smallest count out of the heap
+// a root whose count grew since it was pushed goes back with its new count
+// (counts only grow, so the root with an up-to-date count is the smallest)
+static tEntry *_smallest(TOPK *topk) {
+    void *dataPtr;
+    tEntry *entry;
+
+    while (1) {
+        heap_Delete(topk->heap, &dataPtr);
+        entry = (tEntry *)dataPtr;
+        if (entry->heap_count == entry->count) return entry;
+        entry->heap_count = entry->count;
+        heap_Insert(topk->heap, entry);
+    }
+}
+
+// Allocates a tracker of k candidates, NULL if overflow
+TOPK *topk_Create(int k) {
+    TOPK *topk;
+
+    if (k < 1) return NULL;
+    topk = (TOPK *)malloc(sizeof(TOPK));
+    if (!topk) return NULL;
+
+    topk->k = k;
+    topk->num = 0;
+    for (topk->size = 1; topk->size < 2 * k; topk->size *= 2)
+        ;
+    topk->heap = heap_Create(compare_by_heap_count);
+    topk->table = (tEntry **)calloc(topk->size, sizeof(tEntry *));
+    if (!topk->heap || !topk->table) {
+        heap_Destroy(topk->heap, free);
+        free(topk->table);
+        free(topk);
+        return NULL;
+    }
+    return topk;
+}
+
+static void destroyEntry(void *dataPtr) {
+    free(((tEntry *)dataPtr)->word);
+    free(dataPtr);
+}
+
+// Free memory for tracker
+void topk_Destroy(TOPK *topk) {
+    if (topk) {
+        heap_Destroy(topk->heap, destroyEntry);
+        free(topk->table);
+        free(topk);
+    }
+}
+
+// count of word became count, return 1 if word is a candidate
+int topk_Update(TOPK *topk, const char *word, long count) {
+    tEntry **link = _find(topk, word);
+    tEntry *entry = *link;
+    char *copy;
+
+    if (entry) { // the heap keeps heap_count, _smallest catches up
+        entry->count = count;
+        return 1;
+    }
+
+    if (topk->num == topk->k) {
+        // the root's heap_count is a lower bound of the smallest count
+        if (count <= ((tEntry *)topk->heap->heapArr[0])->heap_count) return 0;
+
+        entry = _smallest(topk);
+        if (count <= entry->count) {
+            heap_Insert(topk->heap, entry);
+            return 0;
+        }
+        copy = strdup(word);
+        if (!copy) {
+            heap_Insert(topk->heap, entry);
+            return 0;
+        }
+        // the smallest candidate leaves, its entry is reused
+        *_find(topk, entry->word) = entry->next;
+        free(entry->word);
+        link = _find(topk, word);
+    } else {
+        entry = (tEntry *)malloc(sizeof(tEntry));
+        copy = strdup(word);
+        if (!entry || !copy) {
+            free(entry);
+            free(copy);
+            return 0;
+        }
+        topk->num++;
+    }
+
+    entry->word = copy;
+    entry->count = entry->heap_count = count;
+    entry->next = NULL;
+    *link = entry;
+    if (!heap_Insert(topk->heap, entry)) { // the heap does not grow beyond k
+        *link = NULL;
+        destroyEntry(entry);
+        topk->num--;
+        return 0;
+    }
+    return 1;
+}
+
+// Candidates in decreasing order of count, returns number of candidates
+int topk_List(TOPK *topk, tEntry *list[]) {
+    for (int i = 0; i < topk->num; i++) list[i] = (tEntry *)topk->heap->heapArr[i];
+    qsort(list, topk->num, sizeof(tEntry *), compare_by_count);
+    return topk->num;
+}
@@ -0,0 +1,47 @@
+////////////////////////////////////////////////////////////////////////////////
+// top-K words of growing counts (heavy hitters) in O(K) memory
+// K candidates in a min-heap by count (adt_heap.c) and a hash table by word
+// the counts come from outside (e.g. Count-Min sketch estimates) and never decrease
+
+#include "adt_heap.h"
+
+// 후보 단어
+typedef struct entry
+{
+	char			*word;
+	long			count;		// latest count
+	long			heap_count;	// count when it was put into the heap (heap order)
+	struct entry	*next;		// hash chain
+} tEntry;
+
+typedef struct
+{
+	int		k;			// number of candidates kept
+	int		num;		// number of candidates
+	HEAP	*heap;		// candidates, smallest heap_count at the root
+	int		size;		// buckets (power of 2)
+	tEntry	**table;	// hash table of candidates
+} TOPK;
+
+/* Allocates a tracker of k candidates
+	return	tracker
+			NULL if overflow
+*/
+TOPK *topk_Create( int k);
+
+/* Free memory for tracker
+*/
+void topk_Destroy( TOPK *topk);
+
+/* count of word became count
+	word replaces the smallest candidate if count is larger
+	return	1 if word is a candidate
+			0 if not (or overflow)
+*/
+int topk_Update( TOPK *topk, const char *word, long count);
+
+/* Candidates in decreasing order of count (then by word)
+	list has room for k entries
+	return	number of candidates
+*/
+int topk_List( TOPK *topk, tEntry *list[]);
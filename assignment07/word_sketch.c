@@ -0,0 +1,182 @@
+#include <stdio.h>
+#include <stdlib.h> // malloc, realloc, free, qsort, bsearch, atoi, atof
+#include <string.h> // strdup, strcmp
+#include <unistd.h> // getopt
+
+#include "cmsketch.h"
+#include "topk.h"
+
+// approximate top-K words in fixed memory
+// every token is counted in a Count-Min sketch, the K words of the largest estimates are kept in topk
+// memory does not depend on the number of distinct words
+// output : word, estimate, lower bound (estimate - error bound)
+// -x : exact counts too (all tokens kept in memory) for checking the estimates
+// usage: word_sketch [-k K] [-e epsilon] [-d delta] [-x] FILE
+
+// User structure type definition
+// 단어 구조체
+typedef struct {
+	char	*word;		// 단어
+	int		freq;		// 빈도
+} tWord;
+
+////////////////////////////////////////////////////////////////////////////////
+// 정렬 기준 : 단어
+int compare_str( const void *n1, const void *n2)
+{
+	return strcmp( *(char **)n1, *(char **)n2);
+}
+
+// 정렬 기준 : 단어
+int compare_by_word( const void *n1, const void *n2)
+{
+	return strcmp( ((tWord *)n1)->word, ((tWord *)n2)->word);
+}
+
+// 정렬 기준 : 빈도 내림차순, 단어
+int compare_by_freq( const void *n1, const void *n2)
+{
+	tWord *p1 = (tWord *)n1;
+	tWord *p2 = (tWord *)n2;
+
+	if (p1->freq != p2->freq) return p2->freq - p1->freq;
+	return strcmp( p1->word, p2->word);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// exact counts of tokens (sorted in place)
+// return	number of distinct words in words (sorted by word)
+static int count_exact( char **tokens, int num_tokens, tWord *words)
+{
+	int num_words = 0;
+
+	qsort( tokens, num_tokens, sizeof(char *), compare_str);
+	for (int i = 0; i < num_tokens; i++)
+	{
+		if (num_words && strcmp( words[num_words - 1].word, tokens[i]) == 0)
+			words[num_words - 1].freq++;
+		else
+		{
+			words[num_words].word = tokens[i];
+			words[num_words++].freq = 1;
+		}
+	}
+	return num_words;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int main( int argc, char **argv)
+{
+	int k = 10, exact = 0, opt, num;
+	double epsilon = 0.0001, delta = 0.001;
+	char word[100];
+	char **tokens = NULL;
+	int num_tokens = 0, capacity = 0;
+	long bound;
+	CMSKETCH *cms;
+	TOPK *topk;
+	tEntry **list;
+	FILE *fp;
+
+	while ((opt = getopt( argc, argv, "k:e:d:x")) != -1)
+	{
+		switch (opt)
+		{
+			case 'k': k = atoi( optarg); break;
+			case 'e': epsilon = atof( optarg); break;
+			case 'd': delta = atof( optarg); break;
+			case 'x': exact = 1; break;
+			default: optind = argc + 1; break;
+		}
+	}
+	if (optind != argc - 1)
+	{
+		fprintf( stderr, "usage: %s [-k K] [-e epsilon] [-d delta] [-x] FILE\n", argv[0]);
+		fprintf( stderr, "\terror <= epsilon * tokens with probability 1 - delta\n");
+		return 1;
+	}
+
+	if ((fp = fopen( argv[optind], "rt")) == NULL)
+	{
+		fprintf( stderr, "file open error: %s\n", argv[optind]);
+		return 2;
+	}
+
+	cms = cms_Create( epsilon, delta);
+	topk = topk_Create( k);
+	list = (tEntry **)malloc( (k > 0 ? k : 1) * sizeof(tEntry *));
+	if (!cms || !topk || !list)
+	{
+		fprintf( stderr, "Error: k must be at least 1, 0 < epsilon, 0 < delta < 1 (or overflow)\n");
+		return 1;
+	}
+
+	while (fscanf( fp, "%99s", word) != EOF)
+	{
+		// 추정 빈도가 top-K 후보보다 크면 후보가 됨
+		topk_Update( topk, word, cms_Add( cms, word));
+
+		if (exact)
+		{
+			if (num_tokens == capacity)
+			{
+				capacity = capacity ? capacity * 2 : 1024;
+				tokens = (char **)realloc( tokens, capacity * sizeof(char *));
+			}
+			tokens[num_tokens++] = strdup( word);
+		}
+	}
+	fclose( fp);
+
+	num = topk_List( topk, list);
+	bound = cms_Error( cms);
+
+	fprintf( stderr, "%ld tokens, sketch %d x %d (%zu bytes), error bound %ld\n",
+		cms->total, cms->depth, cms->width, (size_t)cms->depth * cms->width * sizeof(unsigned), bound);
+
+	if (!exact)
+	{
+		for (int i = 0; i < num; i++)
+			printf( "%s\t%ld\t%ld\n", list[i]->word, list[i]->count,
+				list[i]->count > bound ? list[i]->count - bound : 0);
+	}
+	else
+	{
+		// true frequency and recall of the top-K
+		tWord *words = (tWord *)malloc( (num_tokens ? num_tokens : 1) * sizeof(tWord));
+		tWord *ranked;
+		int num_words = count_exact( tokens, num_tokens, words);
+		int found = 0, kth;
+		long max_error = 0;
+
+		ranked = (tWord *)malloc( (num_words ? num_words : 1) * sizeof(tWord));
+		memcpy( ranked, words, num_words * sizeof(tWord));
+		qsort( ranked, num_words, sizeof(tWord), compare_by_freq);
+		kth = num_words ? ranked[(k < num_words ? k : num_words) - 1].freq : 0;
+
+		for (int i = 0; i < num; i++)
+		{
+			tWord key = { list[i]->word, 0};
+			tWord *p = (tWord *)bsearch( &key, words, num_words, sizeof(tWord), compare_by_word);
+			int freq = p ? p->freq : 0;
+
+			printf( "%s\t%ld\t%ld\t%d\n", list[i]->word, list[i]->count,
+				list[i]->count > bound ? list[i]->count - bound : 0, freq);
+			if (list[i]->count - freq > max_error) max_error = list[i]->count - freq;
+			if (freq >= kth) found++; // ties with the K-th word count
+		}
+		fprintf( stderr, "%d distinct words, recall %d/%d, max error %ld (bound %ld)\n",
+			num_words, found, k < num_words ? k : num_words, max_error, bound);
+
+		free( ranked);
+		free( words);
+		for (int i = 0; i < num_tokens; i++) free( tokens[i]);
+		free( tokens);
+	}
+
+	free( list);
+	topk_Destroy( topk);
+	cms_Destroy( cms);
+
+	return 0;
+}
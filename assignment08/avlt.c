@@ -2,68 +2,114 @@
 
 #include <stdlib.h> // malloc
 #include <stdio.h>
+#include <pthread.h>
 
 #include "avlt.h"
 
 #define max(x, y)	(((x) > (y)) ? (x) : (y))
 
+// statistics (-DSTATS), see AVLT_Stats
+// atomic (relaxed) because the set operations run on several threads
+#ifdef STATS
+static struct {
+    long compare;       // compare calls
+    long abbrev;        // comparisons decided by abbreviated keys
+    long visit;         // nodes compared on the way down
+    long rotate_left;
+    long rotate_right;
+    long malloc_bytes;  // nodes allocated
+    long reuse;         // nodes taken from the pool
+} stats;
+#define STAT_ADD(c, n)  __atomic_fetch_add(&stats.c, (n), __ATOMIC_RELAXED)
+#else
+#define STAT_ADD(c, n)  ((void)0)
+#endif
+
 // internal functions (not mandatory)
-static NODE *_insert( NODE *root, NODE *newPtr, int (*compare)(const void *, const void *), void (*callback)(void *), int *duplicated);
-static NODE *_makeNode( void *dataInPtr);
-static void _destroy( NODE *root, void (*callback)(void *));
-static NODE *_delete( NODE *root, void *keyPtr, void **dataOutPtr, int (*compare)(const void *, const void *));
-static NODE *_search( NODE *root, void *keyPtr, int (*compare)(const void *, const void *));
+static int _compare( TREE *pTree, NODE *a, NODE *b);
+static void _setKey( TREE *pTree, NODE *node, void *dataPtr);
+static NODE *_insert( TREE *pTree, NODE *root, NODE *newPtr, void (*callback)(void *), int *duplicated);
+static NODE *_makeNode( TREE *pTree, void *dataInPtr);
+static void _destroy( NODE *root, void (*callback)(void *), NODE **pool);
+static void _freePool( TREE *pTree);
+static NODE *_delete( TREE *pTree, NODE *root, NODE *keyNode, void **dataOutPtr);
+static NODE *_search( TREE *pTree, NODE *root, NODE *keyNode);
 static void _traverse( NODE *root, void (*callback)(const void *));
 static void _traverseR( NODE *root, void (*callback)(const void *));
 static void _inorder_print( NODE *root, int level, void (*callback)(const void *));
 static int getHeight( NODE *root);
+static int _count( NODE *root);
+static NODE *_join( NODE *left, NODE *node, NODE *right);
+static NODE *_join2( NODE *left, NODE *right);
+static NODE *_split( TREE *pTree, NODE *root, NODE *keyNode, NODE **left, NODE **right);
+static void _rangeTraverse( TREE *pTree, NODE *root, NODE *lo, NODE *hi, void (*callback)(const void *));
+static int _drop( NODE *root, void (*callback)(void *));
 static NODE *rotateRight( NODE *root);
 static NODE *rotateLeft( NODE *root);
 
 
 TREE *AVLT_Create( int (*compare)(const void *, const void *)) {
+    return AVLT_CreateAbbrev(compare, NULL);
+}
+
+TREE *AVLT_CreateAbbrev( int (*compare)(const void *, const void *), int (*abbrev)(const void *, unsigned long long *)) {
     TREE *tree = (TREE *)malloc(sizeof(TREE));
     if (tree) {
         tree->root = NULL;
         tree->count = 0;
         tree->compare = compare;
+        tree->abbrev = abbrev;
+        tree->pool = NULL;
     }
     return tree;
 }
 
 void AVLT_Destroy( TREE *pTree, void (*callback)(void *)) {
     if (pTree) {
-        _destroy(pTree->root, callback);
+        _destroy(pTree->root, callback, NULL);
+        _freePool(pTree);
         free(pTree);
     }
 }
 
+void AVLT_Clear( TREE *pTree, void (*callback)(void *)) {
+    _destroy(pTree->root, callback, &pTree->pool);
+    pTree->root = NULL;
+    pTree->count = 0;
+}
+
 int AVLT_Insert( TREE *pTree, void *dataInPtr, void (*callback)(void *)) {
     int duplicated = 0;
-    NODE *newNode = _makeNode(dataInPtr);
+    NODE *newNode = _makeNode(pTree, dataInPtr);
     if (!newNode)
         return 0;
 
-    pTree->root = _insert(pTree->root, newNode, pTree->compare, callback, &duplicated);
+    pTree->root = _insert(pTree, pTree->root, newNode, callback, &duplicated);
     if (duplicated) {
-        free(newNode);
+        newNode->right = pTree->pool; // back to the pool for the next insert
+        pTree->pool = newNode;
         return 2;
     }
 
-    pTree->count++;
+    if (pTree->count >= 0)
+        pTree->count++;
     return 1;
 }
 
 void *AVLT_Delete( TREE *pTree, void *keyPtr) {
     void *dataOutPtr = NULL;
-    pTree->root = _delete(pTree->root, keyPtr, &dataOutPtr, pTree->compare);
-    if (dataOutPtr)
+    NODE keyNode;
+    _setKey(pTree, &keyNode, keyPtr);
+    pTree->root = _delete(pTree, pTree->root, &keyNode, &dataOutPtr);
+    if (dataOutPtr && pTree->count >= 0)
         pTree->count--;
     return dataOutPtr;
 }
 
 void *AVLT_Search( TREE *pTree, void *keyPtr) {
-    NODE *node = _search(pTree->root, keyPtr, pTree->compare);
+    NODE keyNode;
+    _setKey(pTree, &keyNode, keyPtr);
+    NODE *node = _search(pTree, pTree->root, &keyNode);
     return node ? node->dataPtr : NULL;
 }
 
@@ -80,6 +126,8 @@ void printTree( TREE *pTree, void (*callback)(const void *)) {
 }
 
 int AVLT_Count( TREE *pTree) {
+    if (pTree->count < 0)
+        pTree->count = _count(pTree->root);
     return pTree->count;
 }
 
@@ -87,19 +135,245 @@ int AVLT_Height( TREE *pTree) {
     return getHeight(pTree->root);
 }
 
+void AVLT_Join( TREE *pTree, TREE *pTree2) {
+    pTree->root = _join2(pTree->root, pTree2->root);
+    if (pTree->count >= 0 && pTree2->count >= 0)
+        pTree->count += pTree2->count;
+    else
+        pTree->count = -1;
+    _freePool(pTree2);
+    free(pTree2);
+}
+
+TREE *AVLT_Split( TREE *pTree, void *keyPtr, void **dataOutPtr) {
+    TREE *tree = AVLT_CreateAbbrev(pTree->compare, pTree->abbrev);
+    NODE keyNode, *found;
+
+    *dataOutPtr = NULL;
+    if (!tree)
+        return NULL;
+
+    _setKey(pTree, &keyNode, keyPtr);
+    found = _split(pTree, pTree->root, &keyNode, &pTree->root, &tree->root);
+    if (found) {
+        *dataOutPtr = found->dataPtr;
+        free(found);
+    }
+
+    // sizes of the parts are counted when needed (AVLT_Count)
+    pTree->count = tree->count = -1;
+    return tree;
+}
+
+void AVLT_RangeTraverse( TREE *pTree, void *loPtr, void *hiPtr, void (*callback)(const void *)) {
+    NODE lo, hi;
+    _setKey(pTree, &lo, loPtr);
+    _setKey(pTree, &hi, hiPtr);
+    _rangeTraverse(pTree, pTree->root, &lo, &hi, callback);
+}
+
+int AVLT_DeleteRange( TREE *pTree, void *loPtr, void *hiPtr, void (*callback)(void *)) {
+    NODE lo, hi, *left, *middle, *right, *found;
+    int n = 0;
+
+    _setKey(pTree, &lo, loPtr);
+    _setKey(pTree, &hi, hiPtr);
+    if (_compare(pTree, &lo, &hi) > 0)
+        return 0;
+
+    // left < lo <= middle <= hi < right
+    found = _split(pTree, pTree->root, &lo, &left, &middle);
+    if (found) {
+        callback(found->dataPtr);
+        free(found);
+        n++;
+    }
+    found = _split(pTree, middle, &hi, &middle, &right);
+    if (found) {
+        callback(found->dataPtr);
+        free(found);
+        n++;
+    }
+    n += _drop(middle, callback);
+
+    pTree->root = _join2(left, right);
+    if (pTree->count >= 0)
+        pTree->count -= n;
+    return n;
+}
+
+// set operations (join-based, Blelloch et al.)
+// the root of the second tree splits the first one, both sides are done in parallel
+// and the results are joined with the root (or without it)
+enum { UNION, INTERSECT, DIFFERENCE };
+
+// parameters of one set operation
+typedef struct {
+    TREE    *tree;
+    int     op;
+    int     (*merge)(void *, void *);
+    void    (*callback)(void *);
+} SETOP;
+
+// argument of a call on another thread
+typedef struct {
+    SETOP   *setop;
+    NODE    *t1, *t2;
+    int     depth;
+    int     removed;
+    NODE    *result;
+} SETARG;
+
+// subtrees lower than this are not worth a thread
+#define PARALLEL_HEIGHT     8
+
+static NODE *_setop( SETOP *s, NODE *t1, NODE *t2, int depth, int *removed);
+
+static void *_setop_thread( void *p) {
+    SETARG *arg = (SETARG *)p;
+    arg->result = _setop(arg->setop, arg->t1, arg->t2, arg->depth, &arg->removed);
+    return NULL;
+}
+
+// removed : nodes of t1 and t2 not in the result
+// return	root of the result
+static NODE *_setop( SETOP *s, NODE *t1, NODE *t2, int depth, int *removed) {
+    NODE *l1, *r1, *l2, *r2, *l, *r, *found, *mid = NULL;
+
+    if (!t1 || !t2) {
+        if (s->op == UNION)
+            return t1 ? t1 : t2;
+        if (s->op == INTERSECT) {
+            *removed += _drop(t1 ? t1 : t2, s->callback);
+            return NULL;
+        }
+        *removed += _drop(t2, s->callback); // DIFFERENCE
+        return t1;
+    }
+
+    l2 = t2->left;
+    r2 = t2->right;
+    found = _split(s->tree, t1, t2, &l1, &r1);
+
+    if (depth > 0 && getHeight(t2) >= PARALLEL_HEIGHT) {
+        pthread_t thread;
+        SETARG arg = { s, l1, l2, depth - 1, 0, NULL};
+
+        if (pthread_create(&thread, NULL, _setop_thread, &arg) == 0) {
+            r = _setop(s, r1, r2, depth - 1, removed);
+            pthread_join(thread, NULL);
+        } else {
+            _setop_thread(&arg);
+            r = _setop(s, r1, r2, depth - 1, removed);
+        }
+        l = arg.result;
+        *removed += arg.removed;
+    } else {
+        l = _setop(s, l1, l2, 0, removed);
+        r = _setop(s, r1, r2, 0, removed);
+    }
+
+    if (found) {
+        // key in both trees : merge decides whether the data of the first tree stays
+        int keep = s->merge ? s->merge(found->dataPtr, t2->dataPtr) : (s->op != DIFFERENCE);
+
+        s->callback(t2->dataPtr);
+        free(t2);
+        (*removed)++;
+        if (keep) {
+            mid = found;
+        } else {
+            s->callback(found->dataPtr);
+            free(found);
+            (*removed)++;
+        }
+    } else if (s->op == UNION) {
+        mid = t2;
+    } else {
+        s->callback(t2->dataPtr);
+        free(t2);
+        (*removed)++;
+    }
+
+    return mid ? _join(l, mid, r) : _join2(l, r);
+}
+
+static void _setop_tree( TREE *pTree, TREE *pTree2, int op, int (*merge)(void *, void *),
+    void (*callback)(void *), int num_thread) {
+    SETOP s = { pTree, op, merge, callback};
+    int removed = 0, depth = 0;
+
+    while ((1 << depth) < num_thread)
+        depth++;
+
+    pTree->root = _setop(&s, pTree->root, pTree2->root, depth, &removed);
+    if (pTree->count >= 0 && pTree2->count >= 0)
+        pTree->count += pTree2->count - removed;
+    else
+        pTree->count = -1;
+    _freePool(pTree2);
+    free(pTree2);
+}
+
+void AVLT_Union( TREE *pTree, TREE *pTree2, int (*merge)(void *, void *), void (*callback)(void *), int num_thread) {
+    _setop_tree(pTree, pTree2, UNION, merge, callback, num_thread);
+}
+
+void AVLT_Intersect( TREE *pTree, TREE *pTree2, int (*merge)(void *, void *), void (*callback)(void *), int num_thread) {
+    _setop_tree(pTree, pTree2, INTERSECT, merge, callback, num_thread);
+}
+
+void AVLT_Difference( TREE *pTree, TREE *pTree2, int (*merge)(void *, void *), void (*callback)(void *), int num_thread) {
+    _setop_tree(pTree, pTree2, DIFFERENCE, merge, callback, num_thread);
+}
+
+void AVLT_Stats( FILE *fp) {
+#ifdef STATS
+    fprintf(fp, "{\"adt\": \"avlt\", \"compare\": %ld, \"abbrev\": %ld, \"visit\": %ld, "
+        "\"rotate_left\": %ld, \"rotate_right\": %ld, \"malloc_bytes\": %ld, \"reuse\": %ld}\n",
+        stats.compare, stats.abbrev, stats.visit,
+        stats.rotate_left, stats.rotate_right, stats.malloc_bytes, stats.reuse);
+#else
+    (void)fp;
+#endif
+}
+
+
 
+// compares data of two nodes
+// abbreviated keys decide unless they are equal (compare is not called)
+static int _compare( TREE *pTree, NODE *a, NODE *b) {
+    STAT_ADD(visit, 1);
+    if (pTree->abbrev) {
+        if (a->key != b->key)
+            return (STAT_ADD(abbrev, 1), (a->key < b->key) ? -1 : 1);
+        if (a->key_full && b->key_full)
+            return (STAT_ADD(abbrev, 1), 0);
+    }
+    STAT_ADD(compare, 1);
+    return pTree->compare(a->dataPtr, b->dataPtr);
+}
+
+// stores data and its abbreviated key into node
+static void _setKey( TREE *pTree, NODE *node, void *dataPtr) {
+    node->dataPtr = dataPtr;
+    node->key = 0;
+    node->key_full = 0;
+    if (pTree->abbrev)
+        node->key_full = pTree->abbrev(dataPtr, &node->key);
+}
 
 // used in AVLT_Insert
 // return 	pointer to root
-static NODE *_insert( NODE *root, NODE *newPtr, int (*compare)(const void *, const void *), void (*callback)(void *), int *duplicated) {
+static NODE *_insert( TREE *pTree, NODE *root, NODE *newPtr, void (*callback)(void *), int *duplicated) {
     if (!root)
         return newPtr;
 
-    int cmp = compare(newPtr->dataPtr, root->dataPtr);
+    int cmp = _compare(pTree, newPtr, root);
     if (cmp < 0) {
-        root->left = _insert(root->left, newPtr, compare, callback, duplicated);
+        root->left = _insert(pTree, root->left, newPtr, callback, duplicated);
     } else if (cmp > 0) {
-        root->right = _insert(root->right, newPtr, compare, callback, duplicated);
+        root->right = _insert(pTree, root->right, newPtr, callback, duplicated);
     } else {
         if (callback)
             callback(root->dataPtr);
@@ -111,15 +385,15 @@ static NODE *_insert( NODE *root, NODE *newPtr, int (*compare)(const void *, con
 
     int balance = getHeight(root->left) - getHeight(root->right);
 
-    if (balance > 1 && compare(newPtr->dataPtr, root->left->dataPtr) < 0)
+    if (balance > 1 && _compare(pTree, newPtr, root->left) < 0)
         return rotateRight(root);
-    if (balance < -1 && compare(newPtr->dataPtr, root->right->dataPtr) > 0)
+    if (balance < -1 && _compare(pTree, newPtr, root->right) > 0)
         return rotateLeft(root);
-    if (balance > 1 && compare(newPtr->dataPtr, root->left->dataPtr) > 0) {
+    if (balance > 1 && _compare(pTree, newPtr, root->left) > 0) {
         root->left = rotateLeft(root->left);
         return rotateRight(root);
     }
-    if (balance < -1 && compare(newPtr->dataPtr, root->right->dataPtr) < 0) {
+    if (balance < -1 && _compare(pTree, newPtr, root->right) < 0) {
         root->right = rotateRight(root->right);
         return rotateLeft(root);
     }
@@ -129,37 +403,68 @@ static NODE *_insert( NODE *root, NODE *newPtr, int (*compare)(const void *, con
 
 
 // used in AVLT_Insert
-static NODE *_makeNode( void *dataInPtr) {
-    NODE *node = (NODE *)malloc(sizeof(NODE));
+// a node kept by AVLT_Clear is used first
+static NODE *_makeNode( TREE *pTree, void *dataInPtr) {
+    NODE *node = pTree->pool;
     if (node) {
-        node->dataPtr = dataInPtr;
+        pTree->pool = node->right;
+        STAT_ADD(reuse, 1);
+    } else {
+        node = (NODE *)malloc(sizeof(NODE));
+        STAT_ADD(malloc_bytes, sizeof(NODE));
+    }
+    if (node) {
+        _setKey(pTree, node, dataInPtr);
         node->left = node->right = NULL;
         node->height = 1;
     }
     return node;
 }
 
+// used in AVLT_Destroy, AVLT_Clear
+// no recursion : left children are rotated up, so the node removed at the root has no left child
+// nodes are freed (pool NULL) or kept in *pool
+static void _destroy( NODE *root, void (*callback)(void *), NODE **pool){
+    while (root) {
+        if (root->left) {
+            NODE *temp = root->left;
+            root->left = temp->right;
+            temp->right = root;
+            root = temp;
+        } else {
+            NODE *temp = root->right;
+            callback(root->dataPtr);
+            if (pool) {
+                root->right = *pool;
+                *pool = root;
+            } else {
+                free(root);
+            }
+            root = temp;
+        }
+    }
+}
+
 // used in AVLT_Destroy
-static void _destroy( NODE *root, void (*callback)(void *)){
-    if (root) {
-        _destroy(root->left, callback);
-        _destroy(root->right, callback);
-        callback(root->dataPtr);
-        free(root);
+static void _freePool( TREE *pTree) {
+    while (pTree->pool) {
+        NODE *node = pTree->pool;
+        pTree->pool = node->right;
+        free(node);
     }
 }
 
 // used in AVLT_Delete
 // return 	pointer to root
-static NODE *_delete(NODE *root, void *keyPtr, void **dataOutPtr, int (*compare)(const void *, const void *)) {
+static NODE *_delete( TREE *pTree, NODE *root, NODE *keyNode, void **dataOutPtr) {
     if (!root)
         return NULL;
 
-    int cmp = compare(keyPtr, root->dataPtr);
+    int cmp = _compare(pTree, keyNode, root);
     if (cmp < 0) {
-        root->left = _delete(root->left, keyPtr, dataOutPtr, compare);
+        root->left = _delete(pTree, root->left, keyNode, dataOutPtr);
     } else if (cmp > 0) {
-        root->right = _delete(root->right, keyPtr, dataOutPtr, compare);
+        root->right = _delete(pTree, root->right, keyNode, dataOutPtr);
     } else {
         *dataOutPtr = root->dataPtr;
 
@@ -177,12 +482,16 @@ static NODE *_delete(NODE *root, void *keyPtr, void **dataOutPtr, int (*compare)
             while (temp->left)
                 temp = temp->left;
 
-            // Swap data
-            void *tempData = root->dataPtr;
+            // Swap data (with abbreviated keys)
+            NODE swapKey = *root;
             root->dataPtr = temp->dataPtr;
-            temp->dataPtr = tempData;
+            root->key = temp->key;
+            root->key_full = temp->key_full;
+            temp->dataPtr = swapKey.dataPtr;
+            temp->key = swapKey.key;
+            temp->key_full = swapKey.key_full;
 
-            root->right = _delete(root->right, temp->dataPtr, dataOutPtr, compare);
+            root->right = _delete(pTree, root->right, &swapKey, dataOutPtr);
         }
     }
 
@@ -215,15 +524,15 @@ static NODE *_delete(NODE *root, void *keyPtr, void **dataOutPtr, int (*compare)
 // Retrieve node containing the requested key
 // return	address of the node containing the key
 //			NULL not found
-static NODE *_search( NODE *root, void *keyPtr, int (*compare)(const void *, const void *)){
+static NODE *_search( TREE *pTree, NODE *root, NODE *keyNode){
     if (!root)
         return NULL;
 
-    int cmp = compare(keyPtr, root->dataPtr);
+    int cmp = _compare(pTree, keyNode, root);
     if (cmp < 0)
-        return _search(root->left, keyPtr, compare);
+        return _search(pTree, root->left, keyNode);
     if (cmp > 0)
-        return _search(root->right, keyPtr, compare);
+        return _search(pTree, root->right, keyNode);
     return root;
 }
 
@@ -273,6 +582,7 @@ static NODE *rotateRight(NODE *root) {
     NODE *newRoot = root->left;
     NODE *temp = newRoot->right;
 
+    STAT_ADD(rotate_right, 1);
     newRoot->right = root;
     root->left = temp;
 
@@ -290,6 +600,7 @@ static NODE *rotateLeft(NODE *root) {
     NODE *newRoot = root->right;
     NODE *temp = newRoot->left;
 
+    STAT_ADD(rotate_left, 1);
     newRoot->left = root;
     root->right = temp;
 
@@ -298,3 +609,147 @@ static NODE *rotateLeft(NODE *root) {
 
     return newRoot;
 }
+
+// internal function
+// return	number of nodes of the (sub)tree
+static int _count( NODE *root) {
+    return root ? 1 + _count(root->left) + _count(root->right) : 0;
+}
+
+// used in AVLT_RangeTraverse
+// subtrees outside [lo, hi] are not visited
+static void _rangeTraverse( TREE *pTree, NODE *root, NODE *lo, NODE *hi, void (*callback)(const void *)) {
+    if (root) {
+        int cmp_lo = _compare(pTree, lo, root);
+        int cmp_hi = _compare(pTree, hi, root);
+        if (cmp_lo < 0)
+            _rangeTraverse(pTree, root->left, lo, hi, callback);
+        if (cmp_lo <= 0 && cmp_hi >= 0)
+            callback(root->dataPtr);
+        if (cmp_hi > 0)
+            _rangeTraverse(pTree, root->right, lo, hi, callback);
+    }
+}
+
+// internal function
+// frees all nodes of root with data
+// return	number of nodes
+static int _drop( NODE *root, void (*callback)(void *)) {
+    int n = 0;
+
+    if (root) {
+        n = 1 + _drop(root->left, callback) + _drop(root->right, callback);
+        callback(root->dataPtr);
+        free(root);
+    }
+    return n;
+}
+
+// internal function
+// makes node the root of left and right, updates its height
+static NODE *_node( NODE *left, NODE *node, NODE *right) {
+    node->left = left;
+    node->right = right;
+    node->height = 1 + max(getHeight(left), getHeight(right));
+    return node;
+}
+
+// used in _join : left is higher than right
+// goes down the right spine of left to a subtree of about the height of right
+static NODE *_joinRight( NODE *left, NODE *node, NODE *right) {
+    NODE *c = left->right;
+
+    if (getHeight(c) <= getHeight(right) + 1) {
+        NODE *t = _node(c, node, right);
+        if (getHeight(t) <= getHeight(left->left) + 1)
+            return _node(left->left, left, t);
+        return rotateLeft(_node(left->left, left, rotateRight(t)));
+    }
+
+    NODE *t = _joinRight(c, node, right);
+    _node(left->left, left, t);
+    if (getHeight(t) <= getHeight(left->left) + 1)
+        return left;
+    return rotateLeft(left);
+}
+
+// used in _join : right is higher than left
+static NODE *_joinLeft( NODE *left, NODE *node, NODE *right) {
+    NODE *c = right->left;
+
+    if (getHeight(c) <= getHeight(left) + 1) {
+        NODE *t = _node(left, node, c);
+        if (getHeight(t) <= getHeight(right->right) + 1)
+            return _node(t, right, right->right);
+        return rotateRight(_node(rotateLeft(t), right, right->right));
+    }
+
+    NODE *t = _joinLeft(left, node, c);
+    _node(t, right, right->right);
+    if (getHeight(t) <= getHeight(right->right) + 1)
+        return right;
+    return rotateRight(right);
+}
+
+// internal function
+// all data of left < node < all data of right
+// O(difference of heights)
+// return	root of the AVL tree of all nodes
+static NODE *_join( NODE *left, NODE *node, NODE *right) {
+    if (getHeight(left) > getHeight(right) + 1)
+        return _joinRight(left, node, right);
+    if (getHeight(right) > getHeight(left) + 1)
+        return _joinLeft(left, node, right);
+    return _node(left, node, right);
+}
+
+// used in _join2
+// removes the last node of root (*last)
+// return	root of the rest
+static NODE *_splitLast( NODE *root, NODE **last) {
+    if (!root->right) {
+        *last = root;
+        return root->left;
+    }
+    NODE *rest = _splitLast(root->right, last);
+    return _join(root->left, root, rest);
+}
+
+// internal function
+// _join without a middle node : the last node of left is used
+static NODE *_join2( NODE *left, NODE *right) {
+    NODE *last;
+
+    if (!left)
+        return right;
+    left = _splitLast(left, &last);
+    return _join(left, last, right);
+}
+
+// internal function
+// splits root into nodes less than keyNode (*left) and greater than keyNode (*right)
+// return	node with the key (not in *left, *right)
+//			NULL not found
+static NODE *_split( TREE *pTree, NODE *root, NODE *keyNode, NODE **left, NODE **right) {
+    NODE *found, *t;
+
+    if (!root) {
+        *left = *right = NULL;
+        return NULL;
+    }
+
+    int cmp = _compare(pTree, keyNode, root);
+    if (cmp == 0) {
+        *left = root->left;
+        *right = root->right;
+        return root;
+    }
+    if (cmp < 0) {
+        found = _split(pTree, root->left, keyNode, left, &t);
+        *right = _join(t, root, root->right);
+    } else {
+        found = _split(pTree, root->right, keyNode, &t, right);
+        *left = _join(root->left, root, t);
+    }
+    return found;
+}
@@ -1,18 +1,26 @@
 ////////////////////////////////////////////////////////////////////////////////
 // TREE type definition
+// avlt.c : AVL tree
+// splay.c : splay tree (the same functions, recently used data near the root)
+#include <stdio.h> // FILE
+
 typedef struct node
 {
 	void 	*dataPtr;
 	struct node	*left;
 	struct node	*right;
 	int 	height; // newly added
+	unsigned long long	key;		// abbreviated key (TREE abbrev)
+	int					key_full;	// key holds the whole key
 } NODE;
 
 typedef struct
 {
-	int 	count;
+	int 	count;		// -1 : not known after AVLT_Split (counted by AVLT_Count)
 	NODE 	*root;
 	int 	(*compare)(const void *, const void *); 
+	int		(*abbrev)(const void *, unsigned long long *); // NULL : compare only
+	NODE	*pool;	// nodes kept by AVLT_Clear for reuse (linked by right)
 } TREE;
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -24,10 +32,26 @@ typedef struct
 */
 TREE *AVLT_Create( int (*compare)(const void *, const void *));
 
+/* AVLT_Create with an abbreviated key cached in each node
+	abbrev(data, &key) stores a number whose order agrees with compare
+	(key1 < key2 means compare < 0), e.g. the first 8 bytes of a string packed big-endian
+	and returns 1 if the key holds the whole key (equal keys mean equal data), 0 otherwise
+	compare is called only when the abbreviated keys are equal
+	return	head node pointer
+			NULL if overflow
+*/
+TREE *AVLT_CreateAbbrev( int (*compare)(const void *, const void *), int (*abbrev)(const void *, unsigned long long *));
+
 /* Deletes all data in tree and recycles memory
+	no recursion
 */
 void AVLT_Destroy( TREE *pTree, void (*callback)(void *));
 
+/* Deletes all data in tree, keeps the nodes for the next insertions
+	(e.g. before the next input file is counted)
+*/
+void AVLT_Clear( TREE *pTree, void (*callback)(void *));
+
 /* Inserts new data into the tree
 	callback은 이미 트리에 존재하는 데이터를 발견했을 때 호출하는 함수
 	return	1 success
@@ -68,3 +92,52 @@ int AVLT_Count( TREE *pTree);
 */
 int AVLT_Height( TREE *pTree);
 
+////////////////////////////////////////////////////////////////////////////////
+// range and join-based operations (avlt.c only)
+// the trees must have the same compare and abbrev functions
+
+/* Appends pTree2 to pTree in O(log n)
+	every data of pTree2 must be greater than every data of pTree
+	pTree2 is freed
+*/
+void AVLT_Join( TREE *pTree, TREE *pTree2);
+
+/* Splits pTree by keyPtr in O(log n)
+	data less than the key stay in pTree, data greater than the key move to the returned tree
+	dataOutPtr : data equal to the key (removed from the tree), NULL if not found
+	return	tree of the greater data
+			NULL if overflow (pTree is not changed)
+*/
+TREE *AVLT_Split( TREE *pTree, void *keyPtr, void **dataOutPtr);
+
+/* inorder traversal of the data from loPtr to hiPtr (both included)
+	only the O(log n + k) nodes on the way are visited
+*/
+void AVLT_RangeTraverse( TREE *pTree, void *loPtr, void *hiPtr, void (*callback)(const void *));
+
+/* Deletes all data from loPtr to hiPtr (both included) in O(log n) plus freeing
+	the tree is split at both keys and the two outer parts are joined again
+	callback frees the deleted data
+	return	number of deleted data
+*/
+int AVLT_DeleteRange( TREE *pTree, void *loPtr, void *hiPtr, void (*callback)(void *));
+
+/* Set operations : pTree becomes the result, pTree2 is consumed (freed)
+	for a key in both trees merge(data, data2) is called (e.g. adds the frequency of data2 to data)
+	and returns 1 to keep data in the result, 0 to drop it
+	merge NULL : data is kept by AVLT_Union and AVLT_Intersect, dropped by AVLT_Difference
+	callback frees the data that are not in the result
+	up to num_thread threads (fork-join), O(m log(n/m + 1)) work for trees of m <= n nodes
+*/
+void AVLT_Union( TREE *pTree, TREE *pTree2, int (*merge)(void *, void *), void (*callback)(void *), int num_thread);
+
+void AVLT_Intersect( TREE *pTree, TREE *pTree2, int (*merge)(void *, void *), void (*callback)(void *), int num_thread);
+
+void AVLT_Difference( TREE *pTree, TREE *pTree2, int (*merge)(void *, void *), void (*callback)(void *), int num_thread);
+
+/* prints the counters of tree operations as one line of JSON
+	(compare calls, comparisons decided by abbreviated keys, nodes compared on the way down,
+	left and right rotations, bytes allocated for nodes, nodes reused from the pool)
+	the counters are compiled in with -DSTATS (make CFLAGS=-DSTATS); otherwise nothing is printed
+*/
+void AVLT_Stats( FILE *fp);
@@ -0,0 +1,247 @@
+////////////////////////////////////////////////////////////////////////////////
+// type-specialised AVL tree (macro template)
+// AVLT_DEFINE( TYPE, CMP) generates an AVL tree whose nodes hold a TYPE value inline
+// (one malloc per node, no void *); CMP( const TYPE *a, const TYPE *b) is a function or macro
+// known at compile time, so it can be inlined (the same convention as compare of avlt.h)
+//
+//	AVLT_DEFINE( tWord, compare_word)
+//	AVLT(tWord) *tree = AVLT_Create_tWord();
+//	ret = AVLT_Insert_tWord( tree, word, &stored);
+//
+// TYPE must be a single identifier (use typedef for struct or pointer types)
+
+#include <stdlib.h> // malloc, free
+
+#define AVLT(TYPE)	AVLT_##TYPE
+
+#define AVLT_DEFINE(TYPE, CMP)																\
+typedef struct AVLT_NODE_##TYPE																\
+{																							\
+	TYPE	data;																			\
+	struct AVLT_NODE_##TYPE	*left;															\
+	struct AVLT_NODE_##TYPE	*right;															\
+	int		height;																			\
+} AVLT_NODE_##TYPE;																			\
+																							\
+typedef struct																				\
+{																							\
+	int					count;																\
+	AVLT_NODE_##TYPE	*root;																\
+} AVLT_##TYPE;																				\
+																							\
+static inline int _avlt_height_##TYPE( AVLT_NODE_##TYPE *root)								\
+{																							\
+	return root ? root->height : 0;															\
+}																							\
+																							\
+static inline void _avlt_update_##TYPE( AVLT_NODE_##TYPE *root)							\
+{																							\
+	int hl = _avlt_height_##TYPE( root->left), hr = _avlt_height_##TYPE( root->right);		\
+	root->height = 1 + (hl > hr ? hl : hr);													\
+}																							\
+																							\
+static inline AVLT_NODE_##TYPE *_avlt_rotateRight_##TYPE( AVLT_NODE_##TYPE *root)			\
+{																							\
+	AVLT_NODE_##TYPE *newRoot = root->left;													\
+	root->left = newRoot->right;															\
+	newRoot->right = root;																	\
+	_avlt_update_##TYPE( root);																\
+	_avlt_update_##TYPE( newRoot);															\
+	return newRoot;																			\
+}																							\
+																							\
+static inline AVLT_NODE_##TYPE *_avlt_rotateLeft_##TYPE( AVLT_NODE_##TYPE *root)			\
+{																							\
+	AVLT_NODE_##TYPE *newRoot = root->right;												\
+	root->right = newRoot->left;															\
+	newRoot->left = root;																	\
+	_avlt_update_##TYPE( root);																\
+	_avlt_update_##TYPE( newRoot);															\
+	return newRoot;																			\
+}																							\
+																							\
+/* restores balance of root after its subtree changed										\
+	return	new root																		\
+*/																							\
+static inline AVLT_NODE_##TYPE *_avlt_balance_##TYPE( AVLT_NODE_##TYPE *root)				\
+{																							\
+	int balance;																			\
+	_avlt_update_##TYPE( root);																\
+	balance = _avlt_height_##TYPE( root->left) - _avlt_height_##TYPE( root->right);			\
+	if (balance > 1)																		\
+	{																						\
+		if (_avlt_height_##TYPE( root->left->left) < _avlt_height_##TYPE( root->left->right))	\
+			root->left = _avlt_rotateLeft_##TYPE( root->left);								\
+		return _avlt_rotateRight_##TYPE( root);												\
+	}																						\
+	if (balance < -1)																		\
+	{																						\
+		if (_avlt_height_##TYPE( root->right->right) < _avlt_height_##TYPE( root->right->left))	\
+			root->right = _avlt_rotateRight_##TYPE( root->right);							\
+		return _avlt_rotateLeft_##TYPE( root);												\
+	}																						\
+	return root;																			\
+}																							\
+																							\
+static AVLT_NODE_##TYPE *_avlt_insert_##TYPE( AVLT_NODE_##TYPE *root, AVLT_NODE_##TYPE *newPtr,	\
+	AVLT_NODE_##TYPE **found)																\
+{																							\
+	int cmp;																				\
+	if (!root) return newPtr;																\
+	cmp = CMP( &newPtr->data, &root->data);													\
+	if (cmp < 0) root->left = _avlt_insert_##TYPE( root->left, newPtr, found);				\
+	else if (cmp > 0) root->right = _avlt_insert_##TYPE( root->right, newPtr, found);		\
+	else																					\
+	{																						\
+		*found = root;																		\
+		return root;																		\
+	}																						\
+	return _avlt_balance_##TYPE( root);														\
+}																							\
+																							\
+static AVLT_NODE_##TYPE *_avlt_delete_##TYPE( AVLT_NODE_##TYPE *root, const TYPE *keyPtr,	\
+	TYPE *dataOutPtr, int *deleted)															\
+{																							\
+	int cmp;																				\
+	if (!root) return NULL;																	\
+	cmp = CMP( keyPtr, &root->data);														\
+	if (cmp < 0) root->left = _avlt_delete_##TYPE( root->left, keyPtr, dataOutPtr, deleted);	\
+	else if (cmp > 0) root->right = _avlt_delete_##TYPE( root->right, keyPtr, dataOutPtr, deleted);	\
+	else if (!root->left || !root->right)													\
+	{																						\
+		AVLT_NODE_##TYPE *child = root->left ? root->left : root->right;					\
+		*dataOutPtr = root->data;															\
+		*deleted = 1;																		\
+		free( root);																		\
+		return child;																		\
+	}																						\
+	else																					\
+	{																						\
+		/* the smallest node of the right subtree takes the place of root */				\
+		AVLT_NODE_##TYPE *minNode = root->right;											\
+		TYPE minData, data = root->data;													\
+		while (minNode->left) minNode = minNode->left;										\
+		minData = minNode->data;															\
+		root->right = _avlt_delete_##TYPE( root->right, &minData, &minData, deleted);		\
+		root->data = minData;																\
+		*dataOutPtr = data;																	\
+	}																						\
+	return _avlt_balance_##TYPE( root);														\
+}																							\
+																							\
+static void _avlt_destroy_##TYPE( AVLT_NODE_##TYPE *root, void (*callback)(TYPE *))		\
+{																							\
+	if (root)																				\
+	{																						\
+		_avlt_destroy_##TYPE( root->left, callback);										\
+		_avlt_destroy_##TYPE( root->right, callback);										\
+		if (callback) callback( &root->data);												\
+		free( root);																		\
+	}																						\
+}																							\
+																							\
+static void _avlt_traverse_##TYPE( AVLT_NODE_##TYPE *root, void (*callback)(const TYPE *))	\
+{																							\
+	if (root)																				\
+	{																						\
+		_avlt_traverse_##TYPE( root->left, callback);										\
+		callback( &root->data);																\
+		_avlt_traverse_##TYPE( root->right, callback);										\
+	}																						\
+}																							\
+																							\
+/* Allocates dynamic memory for a tree head node											\
+	return	NULL if overflow																\
+*/																							\
+static inline AVLT_##TYPE *AVLT_Create_##TYPE( void)										\
+{																							\
+	AVLT_##TYPE *tree = (AVLT_##TYPE *)malloc( sizeof(AVLT_##TYPE));						\
+	if (tree)																				\
+	{																						\
+		tree->count = 0;																	\
+		tree->root = NULL;																	\
+	}																						\
+	return tree;																			\
+}																							\
+																							\
+/* Deletes all data in tree (callback may be NULL)											\
+*/																							\
+static inline void AVLT_Destroy_##TYPE( AVLT_##TYPE *pTree, void (*callback)(TYPE *))		\
+{																							\
+	if (pTree)																				\
+	{																						\
+		_avlt_destroy_##TYPE( pTree->root, callback);										\
+		free( pTree);																		\
+	}																						\
+}																							\
+																							\
+/* Inserts a copy of data into the tree														\
+	storedPtr (if not NULL) receives the address of the value in the tree					\
+	(the existing one for a duplicated key, e.g. to increase its frequency)					\
+	return	0 overflow																		\
+			1 success																		\
+			2 if duplicated key																\
+*/																							\
+static inline int AVLT_Insert_##TYPE( AVLT_##TYPE *pTree, TYPE data, TYPE **storedPtr)		\
+{																							\
+	AVLT_NODE_##TYPE *found = NULL;															\
+	AVLT_NODE_##TYPE *newNode = (AVLT_NODE_##TYPE *)malloc( sizeof(AVLT_NODE_##TYPE));		\
+	if (!newNode) return 0;																	\
+	newNode->data = data;																	\
+	newNode->left = newNode->right = NULL;													\
+	newNode->height = 1;																	\
+	pTree->root = _avlt_insert_##TYPE( pTree->root, newNode, &found);						\
+	if (found)																				\
+	{																						\
+		free( newNode);																		\
+		if (storedPtr) *storedPtr = &found->data;											\
+		return 2;																			\
+	}																						\
+	if (storedPtr) *storedPtr = &newNode->data;												\
+	pTree->count++;																			\
+	return 1;																				\
+}																							\
+																							\
+/* Deletes the value with keyPtr from the tree and copies it to dataOutPtr					\
+	return	1 deleted																		\
+			0 not found																		\
+*/																							\
+static inline int AVLT_Delete_##TYPE( AVLT_##TYPE *pTree, const TYPE *keyPtr, TYPE *dataOutPtr)	\
+{																							\
+	int deleted = 0;																		\
+	pTree->root = _avlt_delete_##TYPE( pTree->root, keyPtr, dataOutPtr, &deleted);			\
+	if (deleted) pTree->count--;															\
+	return deleted;																			\
+}																							\
+																							\
+/* return	address of the value containing the key											\
+			NULL not found																	\
+*/																							\
+static inline TYPE *AVLT_Search_##TYPE( AVLT_##TYPE *pTree, const TYPE *keyPtr)			\
+{																							\
+	AVLT_NODE_##TYPE *root = pTree->root;													\
+	while (root)																			\
+	{																						\
+		int cmp = CMP( keyPtr, &root->data);												\
+		if (cmp == 0) return &root->data;													\
+		root = (cmp < 0) ? root->left : root->right;										\
+	}																						\
+	return NULL;																			\
+}																							\
+																							\
+/* inorder traversal																		\
+*/																							\
+static inline void AVLT_Traverse_##TYPE( AVLT_##TYPE *pTree, void (*callback)(const TYPE *))	\
+{																							\
+	_avlt_traverse_##TYPE( pTree->root, callback);											\
+}																							\
+																							\
+static inline int AVLT_Count_##TYPE( AVLT_##TYPE *pTree)									\
+{																							\
+	return pTree->count;																	\
+}																							\
+																							\
+static inline int AVLT_Height_##TYPE( AVLT_##TYPE *pTree)									\
+{																							\
+	return _avlt_height_##TYPE( pTree->root);												\
+}
@@ -0,0 +1,31 @@
+////////////////////////////////////////////////////////////////////////////////
+// TREE_* names of the tree benchmarks (query_bench.c, range_bench.c, teardown_bench.c)
+// avlt.h API (linked with avlt.o or splay.o), or with -DUSE_BST the BST of ../assignment06
+
+#ifdef USE_BST
+#include "bst.h"
+#define TREE_Create			BST_Create
+#define TREE_Destroy		BST_Destroy
+#define TREE_Clear			BST_Clear
+#define TREE_Insert			BST_Insert
+#define TREE_Delete			BST_Delete
+#define TREE_Search			BST_Search
+#define TREE_Traverse		BST_Traverse
+#define TREE_RangeTraverse	BST_RangeTraverse
+#define TREE_DeleteRange	BST_DeleteRange
+#define TREE_Count			BST_Count
+#define TREE_Stats			BST_Stats
+#else
+#include "avlt.h"
+#define TREE_Create			AVLT_Create
+#define TREE_Destroy		AVLT_Destroy
+#define TREE_Clear			AVLT_Clear
+#define TREE_Insert			AVLT_Insert
+#define TREE_Delete			AVLT_Delete
+#define TREE_Search			AVLT_Search
+#define TREE_Traverse		AVLT_Traverse
+#define TREE_RangeTraverse	AVLT_RangeTraverse
+#define TREE_DeleteRange	AVLT_DeleteRange
+#define TREE_Count			AVLT_Count
+#define TREE_Stats			AVLT_Stats
+#endif
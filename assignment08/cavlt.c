@@ -0,0 +1,450 @@
+#include <stdlib.h> // malloc, calloc
+
+#include "cavlt.h"
+
+// concurrent AVL tree
+// an update works on a private copy of the search path :
+// nodes whose version is the current update are new and may be changed, any other node is
+// copied first (_own) and the old one is retired; the new root is published at the end
+// readers follow child pointers of published nodes, which never change
+
+#define max(x, y)	(((x) > (y)) ? (x) : (y))
+
+#define LOAD(p)			__atomic_load_n( (p), __ATOMIC_ACQUIRE)
+
+// replaced nodes are checked for reclamation every RECLAIM_BATCH retirements
+#define RECLAIM_BATCH	256
+
+// one update (writer)
+typedef struct
+{
+	CTREE	*tree;
+	CNODE	*pool;		// preallocated nodes (linked by left), so an update never fails halfway
+	CNODE	*retired;	// nodes replaced by this update
+} UPDATE;
+
+////////////////////////////////////////////////////////////////////////////////
+// epoch-based reclamation
+// a reader announces the global epoch while it reads; the global epoch moves from e to e+1
+// only when every reading thread has announced e, so a node retired in epoch e (after the
+// root that replaced it was published) is freed once the global epoch reaches e+2
+
+static void _enter( CTREE *pTree, int tid)
+{
+	__atomic_store_n( &pTree->reader[tid].epoch, LOAD( &pTree->epoch), __ATOMIC_SEQ_CST);
+}
+
+static void _leave( CTREE *pTree, int tid)
+{
+	__atomic_store_n( &pTree->reader[tid].epoch, 0, __ATOMIC_RELEASE);
+}
+
+static void _try_advance( CTREE *pTree)
+{
+	unsigned long epoch = pTree->epoch; // changed by writers only
+
+	for (int t = 0; t < CAVLT_MAX_READER; t++)
+	{
+		unsigned long e = __atomic_load_n( &pTree->reader[t].epoch, __ATOMIC_SEQ_CST);
+		if (e != 0 && e != epoch) return;
+	}
+	__atomic_store_n( &pTree->epoch, epoch + 1, __ATOMIC_SEQ_CST);
+}
+
+static void _free_node( CNODE *node)
+{
+	if (node->retire) node->retire( node->dataPtr);
+	free( node);
+}
+
+// frees replaced nodes that no reader can see any more (writer)
+static void _reclaim( CTREE *pTree)
+{
+	CNODE **link = &pTree->retired;
+
+	_try_advance( pTree);
+	while (*link)
+	{
+		CNODE *node = *link;
+		if (node->retired_epoch + 2 <= pTree->epoch)
+		{
+			*link = node->retired_link;
+			_free_node( node);
+			pTree->num_retired--;
+		}
+		else link = &node->retired_link;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// internal functions for updates
+
+// takes a new node from the pool
+static CNODE *_new( UPDATE *u, void *dataPtr, CNODE *left, CNODE *right, int height)
+{
+	CNODE *node = u->pool;
+
+	u->pool = node->left;
+	node->dataPtr = dataPtr;
+	node->left = left;
+	node->right = right;
+	node->height = height;
+	node->version = u->tree->version;
+	node->retire = NULL;
+	return node;
+}
+
+// returns node if it belongs to this update, otherwise its copy (the node is retired)
+static CNODE *_own( UPDATE *u, CNODE *node)
+{
+	CNODE *copy;
+
+	if (node->version == u->tree->version) return node;
+
+	copy = _new( u, node->dataPtr, node->left, node->right, node->height);
+	node->retired_link = u->retired;
+	u->retired = node;
+	return copy;
+}
+
+// retires a node that leaves the tree
+static void _drop( UPDATE *u, CNODE *node)
+{
+	node->retired_link = u->retired;
+	u->retired = node;
+}
+
+static int getHeight( CNODE *root)
+{
+	return root ? root->height : 0;
+}
+
+static void _update( CNODE *root)
+{
+	root->height = 1 + max( getHeight( root->left), getHeight( root->right));
+}
+
+// root belongs to the update
+static CNODE *rotateRight( UPDATE *u, CNODE *root)
+{
+	CNODE *newRoot = _own( u, root->left);
+
+	root->left = newRoot->right;
+	newRoot->right = root;
+	_update( root);
+	_update( newRoot);
+	return newRoot;
+}
+
+static CNODE *rotateLeft( UPDATE *u, CNODE *root)
+{
+	CNODE *newRoot = _own( u, root->right);
+
+	root->right = newRoot->left;
+	newRoot->left = root;
+	_update( root);
+	_update( newRoot);
+	return newRoot;
+}
+
+// restores balance of root (belongs to the update)
+// return	new root
+static CNODE *_balance( UPDATE *u, CNODE *root)
+{
+	int balance;
+
+	_update( root);
+	balance = getHeight( root->left) - getHeight( root->right);
+
+	if (balance > 1)
+	{
+		if (getHeight( root->left->left) < getHeight( root->left->right))
+			root->left = rotateLeft( u, _own( u, root->left));
+		return rotateRight( u, root);
+	}
+	if (balance < -1)
+	{
+		if (getHeight( root->right->right) < getHeight( root->right->left))
+			root->right = rotateRight( u, _own( u, root->right));
+		return rotateLeft( u, root);
+	}
+	return root;
+}
+
+// result	1 inserted, 2 duplicated
+// return	new root of the subtree
+static CNODE *_insert( UPDATE *u, CNODE *root, void *dataInPtr, void (*callback)(void *), int *result)
+{
+	CNODE *child;
+	int cmp;
+
+	if (!root)
+	{
+		*result = 1;
+		return _new( u, dataInPtr, NULL, NULL, 1);
+	}
+
+	cmp = u->tree->compare( dataInPtr, root->dataPtr);
+	if (cmp == 0)
+	{
+		if (callback) callback( root->dataPtr);
+		*result = 2;
+		return root;
+	}
+
+	child = _insert( u, (cmp < 0) ? root->left : root->right, dataInPtr, callback, result);
+	if (*result != 1) return root;
+
+	root = _own( u, root);
+	if (cmp < 0) root->left = child;
+	else root->right = child;
+	return _balance( u, root);
+}
+
+// deleted	1 if found
+// the node that carries the deleted data gets retire (NULL : data moves to another node)
+// return	new root of the subtree
+static CNODE *_delete( UPDATE *u, CNODE *root, void *keyPtr, void (*retire)(void *), int *deleted)
+{
+	CNODE *child;
+	int cmp;
+
+	if (!root) return NULL;
+
+	cmp = u->tree->compare( keyPtr, root->dataPtr);
+	if (cmp != 0)
+	{
+		child = _delete( u, (cmp < 0) ? root->left : root->right, keyPtr, retire, deleted);
+		if (!*deleted) return root;
+
+		root = _own( u, root);
+		if (cmp < 0) root->left = child;
+		else root->right = child;
+		return _balance( u, root);
+	}
+
+	*deleted = 1;
+	if (!root->left || !root->right)
+	{
+		child = root->left ? root->left : root->right;
+		root->retire = retire;
+		_drop( u, root);
+		return child;
+	}
+
+	// the smallest node of the right subtree takes the place of root
+	CNODE *minNode = root->right;
+	int found = 0;
+
+	while (minNode->left) minNode = minNode->left;
+	child = _delete( u, root->right, minNode->dataPtr, NULL, &found);
+
+	root->retire = retire; // root is copied : the old node carries the deleted data
+	root = _own( u, root);
+	root->retire = NULL;
+	root->dataPtr = minNode->dataPtr;
+	root->right = child;
+	return _balance( u, root);
+}
+
+// prepares an update (lock held) : enough nodes for the copies of one path and its rotations
+// return	1 if successful
+//			0 if overflow
+static int _begin( CTREE *pTree, UPDATE *u)
+{
+	int num_nodes = 3 * (getHeight( pTree->root) + 2);
+
+	u->tree = pTree;
+	u->pool = NULL;
+	u->retired = NULL;
+	pTree->version++;
+
+	for (int i = 0; i < num_nodes; i++)
+	{
+		CNODE *node = (CNODE *)malloc( sizeof(CNODE));
+		if (!node)
+		{
+			while (u->pool)
+			{
+				node = u->pool;
+				u->pool = node->left;
+				free( node);
+			}
+			return 0;
+		}
+		node->left = u->pool;
+		u->pool = node;
+	}
+	return 1;
+}
+
+// publishes root and retires the replaced nodes (lock held)
+static void _commit( CTREE *pTree, UPDATE *u, CNODE *root)
+{
+	__atomic_store_n( &pTree->root, root, __ATOMIC_RELEASE);
+
+	// readers that start from now on cannot reach the replaced nodes
+	unsigned long epoch = __atomic_load_n( &pTree->epoch, __ATOMIC_SEQ_CST);
+	while (u->retired)
+	{
+		CNODE *node = u->retired;
+		u->retired = node->retired_link;
+		node->retired_epoch = epoch;
+		node->retired_link = pTree->retired;
+		pTree->retired = node;
+		pTree->num_retired++;
+	}
+
+	while (u->pool)
+	{
+		CNODE *node = u->pool;
+		u->pool = node->left;
+		free( node);
+	}
+
+	if (pTree->num_retired >= RECLAIM_BATCH) _reclaim( pTree);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+CTREE *CAVLT_Create( int (*compare)(const void *, const void *))
+{
+	CTREE *tree = (CTREE *)calloc( 1, sizeof(CTREE));
+	if (tree)
+	{
+		tree->compare = compare;
+		tree->epoch = 1;
+		pthread_mutex_init( &tree->lock, NULL);
+	}
+	return tree;
+}
+
+static void _destroy( CNODE *root, void (*callback)(void *))
+{
+	if (root)
+	{
+		_destroy( root->left, callback);
+		_destroy( root->right, callback);
+		callback( root->dataPtr);
+		free( root);
+	}
+}
+
+void CAVLT_Destroy( CTREE *pTree, void (*callback)(void *))
+{
+	if (pTree)
+	{
+		_destroy( pTree->root, callback);
+		while (pTree->retired)
+		{
+			CNODE *node = pTree->retired;
+			pTree->retired = node->retired_link;
+			_free_node( node);
+		}
+		pthread_mutex_destroy( &pTree->lock);
+		free( pTree);
+	}
+}
+
+int CAVLT_Insert( CTREE *pTree, void *dataInPtr, void (*callback)(void *))
+{
+	UPDATE u;
+	CNODE *root;
+	int result = 0;
+
+	pthread_mutex_lock( &pTree->lock);
+	if (_begin( pTree, &u))
+	{
+		root = _insert( &u, pTree->root, dataInPtr, callback, &result);
+		if (result == 1) pTree->count++;
+		_commit( pTree, &u, root);
+	}
+	pthread_mutex_unlock( &pTree->lock);
+
+	return result;
+}
+
+int CAVLT_Delete( CTREE *pTree, void *keyPtr, void (*retire)(void *))
+{
+	UPDATE u;
+	CNODE *root;
+	int deleted = 0;
+
+	pthread_mutex_lock( &pTree->lock);
+	if (_begin( pTree, &u))
+	{
+		root = _delete( &u, pTree->root, keyPtr, retire, &deleted);
+		if (deleted) pTree->count--;
+		_commit( pTree, &u, root);
+	}
+	pthread_mutex_unlock( &pTree->lock);
+
+	return deleted;
+}
+
+// node containing keyPtr in the published version (inside _enter / _leave)
+static CNODE *_search( CTREE *pTree, void *keyPtr)
+{
+	CNODE *root = LOAD( &pTree->root);
+
+	while (root)
+	{
+		int cmp = pTree->compare( keyPtr, root->dataPtr);
+		if (cmp == 0) break;
+		root = (cmp < 0) ? root->left : root->right;
+	}
+	return root;
+}
+
+void *CAVLT_Search( CTREE *pTree, int tid, void *keyPtr)
+{
+	CNODE *node;
+	void *dataPtr = NULL;
+
+	_enter( pTree, tid);
+	node = _search( pTree, keyPtr);
+	if (node) dataPtr = node->dataPtr;
+	_leave( pTree, tid);
+
+	return dataPtr;
+}
+
+int CAVLT_SearchApply( CTREE *pTree, int tid, void *keyPtr, int (*callback)(const void *))
+{
+	CNODE *node;
+	int ret = 0;
+
+	_enter( pTree, tid);
+	node = _search( pTree, keyPtr);
+	if (node) ret = callback( node->dataPtr);
+	_leave( pTree, tid);
+
+	return ret;
+}
+
+static void _traverse( CNODE *root, void (*callback)(const void *))
+{
+	if (root)
+	{
+		_traverse( root->left, callback);
+		callback( root->dataPtr);
+		_traverse( root->right, callback);
+	}
+}
+
+void CAVLT_Traverse( CTREE *pTree, int tid, void (*callback)(const void *))
+{
+	_enter( pTree, tid);
+	_traverse( LOAD( &pTree->root), callback);
+	_leave( pTree, tid);
+}
+
+int CAVLT_Count( CTREE *pTree)
+{
+	return __atomic_load_n( &pTree->count, __ATOMIC_RELAXED);
+}
+
+int CAVLT_Height( CTREE *pTree)
+{
+	CNODE *root = LOAD( &pTree->root);
+	return getHeight( root);
+}
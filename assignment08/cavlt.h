@@ -0,0 +1,100 @@
+////////////////////////////////////////////////////////////////////////////////
+// concurrent AVL tree (read-mostly)
+// writers (CAVLT_Insert, CAVLT_Delete) are serialized by a mutex and never modify a published
+// node : the nodes on the updated path are copied (with the rotations), then the new root is
+// published with one atomic store
+// readers (CAVLT_Search, CAVLT_SearchApply, CAVLT_Traverse) take no lock and never wait; each passes its own
+// reader number tid (0 .. CAVLT_MAX_READER-1) and sees one consistent version of the tree
+// replaced nodes are freed by epoch-based reclamation after no reader can still see them
+#include <pthread.h>
+
+#define CAVLT_MAX_READER	64
+
+typedef struct cnode
+{
+	void			*dataPtr;
+	struct cnode	*left;
+	struct cnode	*right;
+	int				height;
+	unsigned long	version;		// update that created the node (may be modified until published)
+	unsigned long	retired_epoch;
+	struct cnode	*retired_link;
+	void			(*retire)(void *);	// frees dataPtr when the node is reclaimed (removed data)
+} CNODE;
+
+// reader state, padded to a cache line
+typedef struct
+{
+	unsigned long	epoch;		// announced epoch while reading, 0 if quiescent
+	char			pad[56];
+} CREADER;
+
+typedef struct
+{
+	CNODE			*root;		// published root
+	int				count;
+	int				(*compare)(const void *, const void *);
+	pthread_mutex_t	lock;		// writers
+	unsigned long	version;	// current update (writers)
+	unsigned long	epoch;		// global epoch (starts at 1)
+	CNODE			*retired;	// replaced nodes (writers)
+	int				num_retired;
+	CREADER			reader[CAVLT_MAX_READER];
+} CTREE;
+
+////////////////////////////////////////////////////////////////////////////////
+// Prototype declarations
+
+/* Allocates dynamic memory for a tree head node and returns its address to caller
+	return	head node pointer
+			NULL if overflow
+*/
+CTREE *CAVLT_Create( int (*compare)(const void *, const void *));
+
+/* Deletes all data in tree and recycles memory
+	no other thread may use the tree
+*/
+void CAVLT_Destroy( CTREE *pTree, void (*callback)(void *));
+
+/* Inserts new data into the tree (writer)
+	callback은 이미 트리에 존재하는 데이터를 발견했을 때 호출하는 함수
+	(readers may read the data at the same time, e.g. use an atomic increment)
+	return	1 success
+			0 overflow
+			2 if duplicated key
+*/
+int CAVLT_Insert( CTREE *pTree, void *dataInPtr, void (*callback)(void *));
+
+/* Deletes a node with keyPtr from the tree (writer)
+	retire(data) is called when no reader can access the data any more
+	return	1 deleted
+			0 not found or overflow
+*/
+int CAVLT_Delete( CTREE *pTree, void *keyPtr, void (*retire)(void *));
+
+/* Retrieve tree for the node containing the requested key (keyPtr) (reader)
+	the returned data is not protected : a concurrent CAVLT_Delete may retire it at any time,
+	so dereference it only when no writer deletes this key (use CAVLT_SearchApply otherwise)
+	return	address of data of the node containing the key
+			NULL not found
+*/
+void *CAVLT_Search( CTREE *pTree, int tid, void *keyPtr);
+
+/* Calls callback with the data of the node containing the requested key (keyPtr) (reader)
+	callback runs while the data cannot be reclaimed
+	return	return value of callback
+			0 not found
+*/
+int CAVLT_SearchApply( CTREE *pTree, int tid, void *keyPtr, int (*callback)(const void *));
+
+/* inorder traversal of the current version (reader)
+*/
+void CAVLT_Traverse( CTREE *pTree, int tid, void (*callback)(const void *));
+
+/* returns number of nodes in tree
+*/
+int CAVLT_Count( CTREE *pTree);
+
+/* returns height of the tree
+*/
+int CAVLT_Height( CTREE *pTree);
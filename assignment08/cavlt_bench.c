@@ -0,0 +1,169 @@
+#include <stdio.h>
+#include <stdlib.h> // atoi
+#include <time.h> // clock_gettime
+#include <pthread.h>
+
+#include "cavlt.h"
+#include "bench_util.h"
+
+// concurrent AVL tree benchmark
+// one writer counts the tokens of FILE (then deletes the words) while 0, 1, 2, 4, ... reader
+// threads search the tokens until the writer is done
+// usage: cavlt_bench FILE [max readers]
+
+////////////////////////////////////////////////////////////////////////////////
+// 읽기 스레드가 빈도를 동시에 읽을 수 있음
+static void increase_freq_atomic( void *dataPtr)
+{
+	__atomic_fetch_add( &((tWord *)dataPtr)->freq, 1, __ATOMIC_RELAXED);
+}
+
+// return	height if AVL, -1 otherwise
+static int check_avl( CNODE *root)
+{
+	int lh, rh;
+
+	if (!root) return 0;
+	lh = check_avl( root->left);
+	rh = check_avl( root->right);
+	if (lh < 0 || rh < 0 || lh - rh > 1 || rh - lh > 1) return -1;
+	if (root->height != 1 + (lh > rh ? lh : rh)) return -1;
+	return root->height;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// thread argument
+typedef struct {
+	CTREE	*tree;
+	char	**tokens;
+	int		num_tokens;
+	int		tid;
+	int		*done;		// set by the writer
+	long	searches;
+	long	found;
+} ARG;
+
+// reads the word while the writer cannot free it
+static int has_freq( const void *dataPtr)
+{
+	return __atomic_load_n( &((tWord *)dataPtr)->freq, __ATOMIC_RELAXED) > 0;
+}
+
+// searches the tokens (from its own start position) until the writer is done
+static void *reader_thread( void *p)
+{
+	ARG *arg = (ARG *)p;
+	int i = (int)((long)arg->tid * 7919 % arg->num_tokens);
+
+	arg->searches = arg->found = 0;
+	while (!__atomic_load_n( arg->done, __ATOMIC_ACQUIRE))
+	{
+		tWord key = { arg->tokens[i], 0};
+		arg->found += CAVLT_SearchApply( arg->tree, arg->tid, &key, has_freq);
+		arg->searches++;
+		if (++i == arg->num_tokens) i = 0;
+	}
+	return NULL;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int main( int argc, char **argv)
+{
+	char **tokens;
+	int num_tokens;
+	int max_reader = 8;
+
+	if (argc != 2 && argc != 3) {
+		fprintf( stderr, "usage: %s FILE [max readers]\n", argv[0]);
+		return 1;
+	}
+	if (argc == 3) max_reader = atoi( argv[2]);
+	if (max_reader < 0 || max_reader >= CAVLT_MAX_READER)
+	{
+		fprintf( stderr, "Error: readers must be 0 .. %d\n", CAVLT_MAX_READER - 1);
+		return 1;
+	}
+
+	num_tokens = read_file( argv[1], &tokens);
+	if (num_tokens < 0)
+	{
+		fprintf( stderr, "Error: cannot open file [%s]\n", argv[1]);
+		return 2;
+	}
+
+	if (num_tokens == 0) return 0;
+
+	printf( "readers\tinsert(sec)\tdelete(sec)\tsearch(Mops/s)\twords\theight\tfreq sum\n");
+
+	for (int num_reader = 0; num_reader <= max_reader; num_reader = num_reader ? num_reader * 2 : 1)
+	{
+		pthread_t thread[CAVLT_MAX_READER];
+		ARG arg[CAVLT_MAX_READER];
+		struct timespec start;
+		double t_insert, t_delete, t_all;
+		long searches = 0, deleted = 0, checksum;
+		int done = 0, words, height;
+		CTREE *tree = CAVLT_Create( compare_by_word);
+
+		if (!tree)
+		{
+			printf( "Cannot create a tree\n");
+			return 100;
+		}
+
+		for (int t = 0; t < num_reader; t++)
+		{
+			arg[t].tree = tree;
+			arg[t].tokens = tokens;
+			arg[t].num_tokens = num_tokens;
+			arg[t].tid = t;
+			arg[t].done = &done;
+		}
+
+		clock_gettime( CLOCK_MONOTONIC, &start);
+		for (int t = 0; t < num_reader; t++)
+			pthread_create( &thread[t], NULL, reader_thread, &arg[t]);
+
+		// writer (main thread)
+		for (int i = 0; i < num_tokens; i++)
+		{
+			tWord *pWord = createWord( tokens[i]);
+			int ret = CAVLT_Insert( tree, pWord, increase_freq_atomic);
+			if (ret == 0 || ret == 2) destroyWord( pWord);
+		}
+		t_insert = elapsed( &start);
+
+		words = CAVLT_Count( tree);
+		height = check_avl( tree->root);
+		CAVLT_Traverse( tree, num_reader, check_word); // a free reader number
+		checksum = check_result();
+
+		for (int i = 0; i < num_tokens; i++)
+		{
+			tWord key = { tokens[i], 0};
+			deleted += CAVLT_Delete( tree, &key, destroyWord);
+		}
+		t_delete = elapsed( &start) - t_insert;
+
+		__atomic_store_n( &done, 1, __ATOMIC_RELEASE);
+		for (int t = 0; t < num_reader; t++)
+		{
+			pthread_join( thread[t], NULL);
+			searches += arg[t].searches;
+		}
+		t_all = elapsed( &start);
+
+		printf( "%d\t%.3f\t\t%.3f\t\t%.2f\t\t%d\t%d\t%ld\n", num_reader, t_insert, t_delete,
+			searches / t_all / 1e6, words, height, checksum);
+
+		if (checksum != num_tokens || height < 0 || deleted != words || CAVLT_Count( tree) != 0)
+			fprintf( stderr, "Error: %d readers : freq sum %ld, height %d, deleted %ld of %d\n",
+				num_reader, checksum, height, deleted, words);
+
+		CAVLT_Destroy( tree, destroyWord);
+	}
+
+	free_tokens( tokens, num_tokens);
+
+	return 0;
+}
@@ -0,0 +1,332 @@
+#include <stdio.h>
+#include <stdlib.h> // malloc, calloc, realloc, free, qsort, atoi
+#include <string.h> // strdup, strcmp, strlen
+#include <unistd.h> // getopt
+
+#include "avlt.h"
+#include "adt_heap.h"
+#include "outbuf.h"
+
+// n-gram (n consecutive tokens) frequencies of FILE
+// each distinct token is interned once in an AVL tree and gets an id (1, 2, ...)
+// an n-gram is the n ids packed into one 64-bit key (64 / n bits per id) in an open addressing hash table
+// so a counted n-gram takes 12 bytes, not a string of n words
+// output : "word1 word2 ...\tfreq" in word order, or the K most frequent in decreasing order (-k)
+// usage: ngram_count [-n 1..3] [-k K] FILE
+
+#define MAX_N	3
+
+// User structure type definition
+// 단어 구조체
+typedef struct {
+	char	*word;		// 단어
+	int		freq;		// 빈도
+	int		id;			// n-gram 안의 단어 번호 (1 ..)
+} tWord;
+
+// n-gram table : key 0 is an empty slot (ids start from 1)
+typedef struct {
+	unsigned long long	*key;	// packed ids
+	unsigned			*freq;
+	long				size;	// power of 2
+	long				num;
+} NGRAMS;
+
+// a counted n-gram for the outputs : ids replaced by ranks in word order
+typedef struct {
+	unsigned long long	key;	// packed ranks (the order of keys is the word order)
+	unsigned			freq;
+} tNgram;
+
+////////////////////////////////////////////////////////////////////////////////
+int compare_by_word( const void *n1, const void *n2)
+{
+	return strcmp( ((tWord *)n1)->word, ((tWord *)n2)->word);
+}
+
+void destroyWord( void *pWord)
+{
+	free( ((tWord *)pWord)->word);
+	free( pWord);
+}
+
+// 정렬 기준 : packed ranks
+int compare_by_key( const void *n1, const void *n2)
+{
+	unsigned long long k1 = ((tNgram *)n1)->key, k2 = ((tNgram *)n2)->key;
+	return (k1 > k2) - (k1 < k2);
+}
+
+// for the heap of the K most frequent : smaller freq (then larger key) is larger
+// the root is the first to leave
+int compare_by_freq( const void *n1, const void *n2)
+{
+	const tNgram *p1 = (const tNgram *)n1, *p2 = (const tNgram *)n2;
+
+	if (p1->freq != p2->freq) return (p1->freq < p2->freq) ? 1 : -1;
+	return compare_by_key( n1, n2);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// n-gram table
+
+// murmur3 finalizer
+static unsigned long long mix( unsigned long long h)
+{
+	h ^= h >> 33;
+	h *= 0xff51afd7ed558ccdULL;
+	h ^= h >> 33;
+	h *= 0xc4ceb9fe1a85ec53ULL;
+	h ^= h >> 33;
+	return h;
+}
+
+// return	0 if overflow
+static int ngrams_Init( NGRAMS *t, long size)
+{
+	t->key = (unsigned long long *)calloc( size, sizeof(unsigned long long));
+	t->freq = (unsigned *)malloc( size * sizeof(unsigned));
+	t->size = size;
+	t->num = 0;
+	if (!t->key || !t->freq)
+	{
+		free( t->key);
+		free( t->freq);
+		return 0;
+	}
+	return 1;
+}
+
+// slot of key (an empty slot if key is not in the table)
+static long ngrams_Slot( NGRAMS *t, unsigned long long key)
+{
+	long i = (long)(mix( key) & (t->size - 1));
+
+	while (t->key[i] && t->key[i] != key) i = (i + 1) & (t->size - 1);
+	return i;
+}
+
+// twice the slots when 3/4 full
+// return	0 if overflow
+static int ngrams_Grow( NGRAMS *t)
+{
+	NGRAMS old = *t;
+
+	if (!ngrams_Init( t, old.size * 2))
+	{
+		*t = old;
+		return 0;
+	}
+	for (long i = 0; i < old.size; i++)
+	{
+		if (old.key[i])
+		{
+			long j = ngrams_Slot( t, old.key[i]);
+			t->key[j] = old.key[i];
+			t->freq[j] = old.freq[i];
+		}
+	}
+	t->num = old.num;
+	free( old.key);
+	free( old.freq);
+	return 1;
+}
+
+// counts key once
+// return	0 if overflow
+static int ngrams_Add( NGRAMS *t, unsigned long long key)
+{
+	long i;
+
+	if (4 * (t->num + 1) > 3 * t->size && !ngrams_Grow( t)) return 0;
+
+	i = ngrams_Slot( t, key);
+	if (t->key[i]) t->freq[i]++;
+	else
+	{
+		t->key[i] = key;
+		t->freq[i] = 1;
+		t->num++;
+	}
+	return 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// words in word order : rank[id], word_of[rank]
+static int *rank;
+static char **word_of;
+static int num_ranked;
+
+void rank_word( const void *dataPtr)
+{
+	const tWord *pWord = (const tWord *)dataPtr;
+
+	rank[pWord->id] = ++num_ranked;
+	word_of[num_ranked] = pWord->word;
+}
+
+// prints "word1 word2 ...\tfreq"
+static void print_ngram( const tNgram *g, int n, int bits)
+{
+	for (int j = n - 1; j >= 0; j--)
+	{
+		out_str( word_of[(g->key >> (j * bits)) & ((1ULL << bits) - 1)]);
+		out_char( j ? ' ' : '\t');
+	}
+	out_int( g->freq);
+	out_char( '\n');
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int main( int argc, char **argv)
+{
+	int n = 2, k = 0, opt, bits, max_id;
+	int window[MAX_N], num_tokens = 0;
+	char word[100];
+	tWord key = { word, 0, 0};
+	tWord *pWord;
+	long long string_bytes = 0;
+	tNgram *list;
+	long num;
+	NGRAMS table;
+	TREE *tree;
+	FILE *fp;
+
+	while ((opt = getopt( argc, argv, "n:k:")) != -1)
+	{
+		switch (opt)
+		{
+			case 'n': n = atoi( optarg); break;
+			case 'k': if ((k = atoi( optarg)) < 1) optind = argc + 1; break;
+			default: optind = argc + 1; break;
+		}
+	}
+	if (optind != argc - 1 || n < 1 || n > MAX_N)
+	{
+		fprintf( stderr, "usage: %s [-n 1..%d] [-k K] FILE\n", argv[0], MAX_N);
+		return 1;
+	}
+	bits = (n == 1) ? 32 : 64 / n;
+	max_id = (bits >= 31) ? 0x7fffffff : (1 << bits) - 1;
+
+	fp = fopen( argv[optind], "rt");
+	if (!fp)
+	{
+		fprintf( stderr, "Error: cannot open file [%s]\n", argv[optind]);
+		return 2;
+	}
+
+	tree = AVLT_Create( compare_by_word);
+	if (!tree || !ngrams_Init( &table, 1024))
+	{
+		printf( "Cannot create a tree\n");
+		return 100;
+	}
+
+	while (fscanf( fp, "%99s", word) != EOF)
+	{
+		unsigned long long packed = 0;
+
+		// 단어는 처음 나올 때만 복사됨
+		pWord = (tWord *)AVLT_Search( tree, &key);
+		if (pWord) pWord->freq++;
+		else
+		{
+			if (AVLT_Count( tree) == max_id)
+			{
+				fprintf( stderr, "Error: more than %d words for %d-grams\n", max_id, n);
+				return 100;
+			}
+			pWord = (tWord *)malloc( sizeof(tWord));
+			pWord->word = strdup( word);
+			pWord->freq = 1;
+			pWord->id = AVLT_Count( tree) + 1;
+			if (AVLT_Insert( tree, pWord, NULL) == 0)
+			{
+				fprintf( stderr, "Error: overflow\n");
+				return 100;
+			}
+		}
+
+		// the last n ids
+		for (int j = 0; j < n - 1; j++) window[j] = window[j + 1];
+		window[n - 1] = pWord->id;
+		if (++num_tokens < n) continue;
+
+		for (int j = 0; j < n; j++) packed = (packed << bits) | (unsigned)window[j];
+		if (!ngrams_Add( &table, packed))
+		{
+			fprintf( stderr, "Error: overflow\n");
+			return 100;
+		}
+	}
+	fclose( fp);
+
+	// ids to ranks in word order : packed ranks sort in word order
+	rank = (int *)malloc( (AVLT_Count( tree) + 1) * sizeof(int));
+	word_of = (char **)malloc( (AVLT_Count( tree) + 1) * sizeof(char *));
+	list = (tNgram *)malloc( (table.num ? table.num : 1) * sizeof(tNgram));
+	AVLT_Traverse( tree, rank_word);
+
+	num = 0;
+	for (long i = 0; i < table.size; i++)
+	{
+		unsigned long long packed = 0;
+
+		if (!table.key[i]) continue;
+		for (int j = n - 1; j >= 0; j--)
+		{
+			int id = (int)((table.key[i] >> (j * bits)) & ((1ULL << bits) - 1));
+			packed = (packed << bits) | (unsigned)rank[id];
+			string_bytes += strlen( word_of[rank[id]]) + 1; // "word1 word2\0"
+		}
+		list[num].key = packed;
+		list[num++].freq = table.freq[i];
+	}
+
+	fprintf( stderr, "%d tokens, %d words, %ld %d-grams\n", num_tokens, AVLT_Count( tree), num, n);
+	fprintf( stderr, "table %ld bytes (%ld slots), %lld bytes as strings (keys only)\n",
+		table.size * (long)(sizeof(unsigned long long) + sizeof(unsigned)), table.size, string_bytes);
+	free( table.key);
+	free( table.freq);
+
+	if (!k) // word order
+	{
+		qsort( list, num, sizeof(tNgram), compare_by_key);
+		for (long i = 0; i < num; i++) print_ngram( &list[i], n, bits);
+	}
+	else // K most frequent : the root of the heap is the least frequent of the K
+	{
+		HEAP *heap = heap_Create( compare_by_freq);
+		tNgram **top = (tNgram **)malloc( k * sizeof(tNgram *));
+		void *dataPtr;
+		int num_top = 0;
+
+		for (long i = 0; i < num; i++)
+		{
+			if (num_top < k) num_top += heap_Insert( heap, &list[i]);
+			else if (compare_by_freq( &list[i], heap->heapArr[0]) < 0)
+			{
+				heap_Delete( heap, &dataPtr);
+				heap_Insert( heap, &list[i]);
+			}
+		}
+		for (int i = num_top - 1; i >= 0; i--)
+		{
+			heap_Delete( heap, &dataPtr);
+			top[i] = (tNgram *)dataPtr;
+		}
+		for (int i = 0; i < num_top; i++) print_ngram( top[i], n, bits);
+
+		free( top);
+		heap_Destroy( heap, NULL);
+	}
+	out_flush();
+
+	free( list);
+	free( word_of);
+	free( rank);
+	AVLT_Destroy( tree, destroyWord);
+
+	return 0;
+}
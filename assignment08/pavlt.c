@@ -0,0 +1,350 @@
+#include <stdlib.h> // malloc
+
+#include "pavlt.h"
+
+#define max(x, y)	(((x) > (y)) ? (x) : (y))
+
+// a node may be changed only if it is used by this version alone :
+// its refcnt is 1 and so are the refcnts of all nodes above it.
+// updates go down from the root making every node on the path private (_own),
+// so the nodes reached are always private or private copies
+
+// internal functions
+static int _reserve( PTREE *pTree);
+static PNODE *_takeNode( PTREE *pTree);
+static void _putNode( PTREE *pTree, PNODE *node);
+static void _own( PTREE *pTree, PNODE **link);
+static int _insert( PTREE *pTree, PNODE **link, void *dataInPtr, void (*callback)(void *));
+static void _delete( PTREE *pTree, PNODE **link, void *keyPtr, void (*callback)(void *));
+static PITEM *_deleteMin( PTREE *pTree, PNODE **link);
+static void _balance( PTREE *pTree, PNODE **link);
+static void _release( PNODE *root, void (*callback)(void *));
+static void _releaseItem( PITEM *item, void (*callback)(void *));
+static void _traverse( PNODE *root, void (*callback)(const void *));
+static int getHeight( PNODE *root);
+
+
+PTREE *PAVLT_Create( int (*compare)(const void *, const void *), void *(*clone)(const void *)) {
+    PTREE *tree = (PTREE *)malloc(sizeof(PTREE));
+    if (tree) {
+        tree->root = NULL;
+        tree->count = 0;
+        tree->compare = compare;
+        tree->clone = clone;
+        tree->pool = NULL;
+        tree->num_pool = 0;
+    }
+    return tree;
+}
+
+PTREE *PAVLT_Snapshot( PTREE *pTree) {
+    PTREE *tree = PAVLT_Create(pTree->compare, pTree->clone);
+    if (tree) {
+        tree->root = pTree->root;
+        tree->count = pTree->count;
+        if (tree->root)
+            tree->root->refcnt++;
+    }
+    return tree;
+}
+
+void PAVLT_Destroy( PTREE *pTree, void (*callback)(void *)) {
+    if (pTree) {
+        _release(pTree->root, callback);
+        while (pTree->pool) {
+            PNODE *node = pTree->pool;
+            pTree->pool = node->left;
+            free(node);
+        }
+        free(pTree);
+    }
+}
+
+int PAVLT_Insert( PTREE *pTree, void *dataInPtr, void (*callback)(void *)) {
+    int ret;
+
+    if (!_reserve(pTree))
+        return 0;
+
+    ret = _insert(pTree, &pTree->root, dataInPtr, callback);
+    if (ret == 1)
+        pTree->count++;
+    return ret;
+}
+
+int PAVLT_Delete( PTREE *pTree, void *keyPtr, void (*callback)(void *)) {
+    if (!PAVLT_Search(pTree, keyPtr) || !_reserve(pTree))
+        return 0;
+
+    _delete(pTree, &pTree->root, keyPtr, callback);
+    pTree->count--;
+    return 1;
+}
+
+void *PAVLT_Search( PTREE *pTree, void *keyPtr) {
+    PNODE *root = pTree->root;
+
+    while (root) {
+        int cmp = pTree->compare(keyPtr, root->item->dataPtr);
+        if (cmp == 0)
+            return root->item->dataPtr;
+        root = (cmp < 0) ? root->left : root->right;
+    }
+    return NULL;
+}
+
+void PAVLT_Traverse( PTREE *pTree, void (*callback)(const void *)) {
+    _traverse(pTree->root, callback);
+}
+
+int PAVLT_Count( PTREE *pTree) {
+    return pTree->count;
+}
+
+int PAVLT_Height( PTREE *pTree) {
+    return getHeight(pTree->root);
+}
+
+
+
+// fills the pool with enough nodes for one update (copies of a path and its rotations)
+// so an update never stops halfway
+// return	1 success
+//			0 overflow
+static int _reserve( PTREE *pTree) {
+    int num_nodes = 3 * (getHeight(pTree->root) + 2) + 1;
+
+    while (pTree->num_pool < num_nodes) {
+        PNODE *node = (PNODE *)malloc(sizeof(PNODE));
+        if (!node)
+            return 0;
+        node->left = pTree->pool;
+        pTree->pool = node;
+        pTree->num_pool++;
+    }
+    return 1;
+}
+
+static PNODE *_takeNode( PTREE *pTree) {
+    PNODE *node = pTree->pool;
+    pTree->pool = node->left;
+    pTree->num_pool--;
+    node->refcnt = 1;
+    return node;
+}
+
+// a removed node goes back to the pool (up to the size of one reservation)
+static void _putNode( PTREE *pTree, PNODE *node) {
+    if (pTree->num_pool < 3 * (getHeight(pTree->root) + 2) + 1) {
+        node->left = pTree->pool;
+        pTree->pool = node;
+        pTree->num_pool++;
+    } else {
+        free(node);
+    }
+}
+
+// makes *link private to this version (the parent is private)
+// a shared node is replaced by a copy, which shares the children and data
+static void _own( PTREE *pTree, PNODE **link) {
+    PNODE *node = *link;
+    PNODE *copy;
+
+    if (node->refcnt == 1)
+        return;
+
+    copy = _takeNode(pTree);
+    copy->item = node->item;
+    copy->left = node->left;
+    copy->right = node->right;
+    copy->height = node->height;
+    copy->item->refcnt++;
+    if (copy->left)
+        copy->left->refcnt++;
+    if (copy->right)
+        copy->right->refcnt++;
+
+    node->refcnt--; // still used by other versions
+    *link = copy;
+}
+
+// return	1 inserted, 2 duplicated, 0 overflow (the tree is unchanged)
+static int _insert( PTREE *pTree, PNODE **link, void *dataInPtr, void (*callback)(void *)) {
+    PNODE *root;
+    int cmp, ret;
+
+    if (!*link) {
+        PITEM *item = (PITEM *)malloc(sizeof(PITEM));
+        if (!item)
+            return 0;
+        item->dataPtr = dataInPtr;
+        item->refcnt = 1;
+
+        root = _takeNode(pTree);
+        root->item = item;
+        root->left = root->right = NULL;
+        root->height = 1;
+        *link = root;
+        return 1;
+    }
+
+    _own(pTree, link);
+    root = *link;
+
+    cmp = pTree->compare(dataInPtr, root->item->dataPtr);
+    if (cmp == 0) {
+        if (root->item->refcnt > 1) {
+            // another version uses the data : this version gets a copy
+            PITEM *item = (PITEM *)malloc(sizeof(PITEM));
+            if (!item)
+                return 0;
+            item->dataPtr = pTree->clone(root->item->dataPtr);
+            if (!item->dataPtr) {
+                free(item);
+                return 0;
+            }
+            item->refcnt = 1;
+            root->item->refcnt--;
+            root->item = item;
+        }
+        if (callback)
+            callback(root->item->dataPtr);
+        return 2;
+    }
+
+    ret = _insert(pTree, (cmp < 0) ? &root->left : &root->right, dataInPtr, callback);
+    if (ret == 1)
+        _balance(pTree, link);
+    return ret;
+}
+
+// keyPtr is in the tree
+static void _delete( PTREE *pTree, PNODE **link, void *keyPtr, void (*callback)(void *)) {
+    PNODE *root;
+    int cmp;
+
+    _own(pTree, link);
+    root = *link;
+
+    cmp = pTree->compare(keyPtr, root->item->dataPtr);
+    if (cmp < 0) {
+        _delete(pTree, &root->left, keyPtr, callback);
+    } else if (cmp > 0) {
+        _delete(pTree, &root->right, keyPtr, callback);
+    } else if (root->left && root->right) {
+        // the smallest data of the right subtree takes the place of the data
+        PITEM *item = _deleteMin(pTree, &root->right);
+        _releaseItem(root->item, callback);
+        root->item = item;
+    } else {
+        *link = root->left ? root->left : root->right;
+        _releaseItem(root->item, callback);
+        _putNode(pTree, root);
+        return;
+    }
+    _balance(pTree, link);
+}
+
+// removes the leftmost node of the subtree
+// return	its data
+static PITEM *_deleteMin( PTREE *pTree, PNODE **link) {
+    PNODE *root;
+    PITEM *item;
+
+    _own(pTree, link);
+    root = *link;
+
+    if (!root->left) {
+        item = root->item;
+        *link = root->right;
+        _putNode(pTree, root);
+        return item;
+    }
+
+    item = _deleteMin(pTree, &root->left);
+    _balance(pTree, link);
+    return item;
+}
+
+static void _update( PNODE *root) {
+    root->height = 1 + max(getHeight(root->left), getHeight(root->right));
+}
+
+// *link is private
+static void _rotateRight( PTREE *pTree, PNODE **link) {
+    PNODE *root = *link;
+    PNODE *newRoot;
+
+    _own(pTree, &root->left);
+    newRoot = root->left;
+    root->left = newRoot->right;
+    newRoot->right = root;
+    *link = newRoot;
+    _update(root);
+    _update(newRoot);
+}
+
+static void _rotateLeft( PTREE *pTree, PNODE **link) {
+    PNODE *root = *link;
+    PNODE *newRoot;
+
+    _own(pTree, &root->right);
+    newRoot = root->right;
+    root->right = newRoot->left;
+    newRoot->left = root;
+    *link = newRoot;
+    _update(root);
+    _update(newRoot);
+}
+
+// restores height and balance of *link (private)
+static void _balance( PTREE *pTree, PNODE **link) {
+    PNODE *root = *link;
+    int balance;
+
+    _update(root);
+    balance = getHeight(root->left) - getHeight(root->right);
+
+    if (balance > 1) {
+        if (getHeight(root->left->left) < getHeight(root->left->right)) {
+            _own(pTree, &root->left);
+            _rotateLeft(pTree, &root->left);
+        }
+        _rotateRight(pTree, link);
+    } else if (balance < -1) {
+        if (getHeight(root->right->right) < getHeight(root->right->left)) {
+            _own(pTree, &root->right);
+            _rotateRight(pTree, &root->right);
+        }
+        _rotateLeft(pTree, link);
+    }
+}
+
+// drops one reference to root
+static void _release( PNODE *root, void (*callback)(void *)) {
+    if (root && --root->refcnt == 0) {
+        _release(root->left, callback);
+        _release(root->right, callback);
+        _releaseItem(root->item, callback);
+        free(root);
+    }
+}
+
+static void _releaseItem( PITEM *item, void (*callback)(void *)) {
+    if (--item->refcnt == 0) {
+        callback(item->dataPtr);
+        free(item);
+    }
+}
+
+static void _traverse( PNODE *root, void (*callback)(const void *)) {
+    if (root) {
+        _traverse(root->left, callback);
+        callback(root->item->dataPtr);
+        _traverse(root->right, callback);
+    }
+}
+
+static int getHeight( PNODE *root) {
+    return root ? root->height : 0;
+}
@@ -0,0 +1,90 @@
+////////////////////////////////////////////////////////////////////////////////
+// persistent AVL tree (path copying)
+// PAVLT_Snapshot returns a frozen version of the tree in O(1); the versions share their nodes
+// an update copies only the shared nodes on its path (O(log n) new nodes per update),
+// nodes used by one version only are changed in place as in avlt.c
+// nodes and data are reference counted : they are freed when no version uses them
+// every version is a PTREE and is updated and destroyed with the same functions
+
+// data shared by the nodes of several versions
+typedef struct pitem
+{
+	void	*dataPtr;
+	int		refcnt;		// nodes
+} PITEM;
+
+typedef struct pnode
+{
+	PITEM	*item;
+	struct pnode	*left;
+	struct pnode	*right;
+	int		height;
+	int		refcnt;		// parent nodes and versions (root)
+} PNODE;
+
+typedef struct
+{
+	int		count;
+	PNODE	*root;
+	int		(*compare)(const void *, const void *);
+	void	*(*clone)(const void *);	// copies data before a shared data is changed
+	PNODE	*pool;		// spare nodes of this version (linked by left)
+	int		num_pool;
+} PTREE;
+
+////////////////////////////////////////////////////////////////////////////////
+// Prototype declarations
+
+/* Allocates dynamic memory for a tree head node and returns its address to caller
+	clone(data) returns a copy of data (NULL if overflow)
+	return	head node pointer
+			NULL if overflow
+*/
+PTREE *PAVLT_Create( int (*compare)(const void *, const void *), void *(*clone)(const void *));
+
+/* Returns a new version with the current contents of the tree in O(1)
+	later updates of either version do not change the other
+	return	head node pointer
+			NULL if overflow
+*/
+PTREE *PAVLT_Snapshot( PTREE *pTree);
+
+/* Deletes the version and recycles memory
+	callback frees data that no other version uses
+*/
+void PAVLT_Destroy( PTREE *pTree, void (*callback)(void *));
+
+/* Inserts new data into the tree
+	callback은 이미 트리에 존재하는 데이터를 발견했을 때 호출하는 함수
+	(the data is cloned first if another version uses it)
+	return	1 success
+			0 overflow
+			2 if duplicated key
+*/
+int PAVLT_Insert( PTREE *pTree, void *dataInPtr, void (*callback)(void *));
+
+/* Deletes a node with keyPtr from the tree
+	callback frees the data if no other version uses it
+	return	1 deleted
+			0 not found or overflow
+*/
+int PAVLT_Delete( PTREE *pTree, void *keyPtr, void (*callback)(void *));
+
+/* Retrieve tree for the node containing the requested key (keyPtr)
+	the data may be shared with other versions : do not change it
+	return	address of data of the node containing the key
+			NULL not found
+*/
+void *PAVLT_Search( PTREE *pTree, void *keyPtr);
+
+/* prints tree using inorder traversal
+*/
+void PAVLT_Traverse( PTREE *pTree, void (*callback)(const void *));
+
+/* returns number of nodes in tree
+*/
+int PAVLT_Count( PTREE *pTree);
+
+/* returns height of the tree
+*/
+int PAVLT_Height( PTREE *pTree);
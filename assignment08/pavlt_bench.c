@@ -0,0 +1,166 @@
+#include <stdio.h>
+#include <stdlib.h> // atoi
+#include <time.h> // clock_gettime
+
+#include "avlt.h"
+#include "pavlt.h"
+#include "bench_util.h"
+
+// snapshots of the word dictionary at checkpoints while counting continues
+// pavlt.c : PAVLT_Snapshot (shared nodes, copied on update)
+// avlt.c : full copy of the tree at every checkpoint (AVLT_Traverse + AVLT_Insert)
+// every snapshot is checked afterwards : frequency sum = tokens counted before the checkpoint
+// usage: pavlt_bench FILE [checkpoints]
+
+#define MAX_CHECKPOINT	100
+
+////////////////////////////////////////////////////////////////////////////////
+static long num_clone;
+
+// for PAVLT_Create function
+void *cloneWord( const void *pNode){
+	const tWord *wordNode = (const tWord *)pNode;
+	tWord *newWord = createWord( wordNode->word);
+	if (newWord) newWord->freq = wordNode->freq;
+	num_clone++;
+	return newWord;
+}
+
+// full copy (avlt.c)
+static TREE *copy_tree;
+
+void copy_word( const void *dataPtr)
+{
+	tWord *pWord = (tWord *)cloneWord( dataPtr);
+	if (AVLT_Insert( copy_tree, pWord, NULL) != 1) destroyWord( pWord);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int main( int argc, char **argv)
+{
+	char **tokens;
+	int num_tokens;
+	int num_checkpoint = 10, errors = 0;
+	long counted[MAX_CHECKPOINT], checksum;
+	PTREE *snapshot[MAX_CHECKPOINT];
+	TREE *copy[MAX_CHECKPOINT];
+	struct timespec start;
+	double t_persistent, t_copy;
+
+	if (argc != 2 && argc != 3) {
+		fprintf( stderr, "usage: %s FILE [checkpoints]\n", argv[0]);
+		return 1;
+	}
+	if (argc == 3) num_checkpoint = atoi( argv[2]);
+	if (num_checkpoint < 1 || num_checkpoint > MAX_CHECKPOINT)
+	{
+		fprintf( stderr, "Error: checkpoints must be 1 .. %d\n", MAX_CHECKPOINT);
+		return 1;
+	}
+
+	num_tokens = read_file( argv[1], &tokens);
+	if (num_tokens < 0)
+	{
+		fprintf( stderr, "Error: cannot open file [%s]\n", argv[1]);
+		return 2;
+	}
+
+	// checkpoint c after token (c + 1) * num_tokens / num_checkpoint
+	for (int c = 0; c < num_checkpoint; c++)
+		counted[c] = (long)(c + 1) * num_tokens / num_checkpoint;
+
+	// persistent tree
+	PTREE *ptree = PAVLT_Create( compare_by_word, cloneWord);
+	if (!ptree)
+	{
+		printf( "Cannot create a tree\n");
+		return 100;
+	}
+
+	clock_gettime( CLOCK_MONOTONIC, &start);
+	for (int i = 0, c = 0; i < num_tokens; i++)
+	{
+		tWord *pWord = createWord( tokens[i]);
+		int ret = PAVLT_Insert( ptree, pWord, increase_freq);
+		if (ret == 0 || ret == 2) destroyWord( pWord);
+
+		while (c < num_checkpoint && counted[c] == i + 1)
+			snapshot[c++] = PAVLT_Snapshot( ptree);
+	}
+	t_persistent = elapsed( &start);
+
+	printf( "%d tokens, %d checkpoints\n", num_tokens, num_checkpoint);
+	printf( "persistent\t%.3f sec\t%ld words copied\n", t_persistent, num_clone);
+
+	// full copies
+	TREE *tree = AVLT_Create( compare_by_word);
+	if (!tree)
+	{
+		printf( "Cannot create a tree\n");
+		return 100;
+	}
+
+	num_clone = 0;
+	clock_gettime( CLOCK_MONOTONIC, &start);
+	for (int i = 0, c = 0; i < num_tokens; i++)
+	{
+		tWord *pWord = createWord( tokens[i]);
+		int ret = AVLT_Insert( tree, pWord, increase_freq);
+		if (ret == 0 || ret == 2) destroyWord( pWord);
+
+		while (c < num_checkpoint && counted[c] == i + 1)
+		{
+			copy_tree = copy[c++] = AVLT_Create( compare_by_word);
+			AVLT_Traverse( tree, copy_word);
+		}
+	}
+	t_copy = elapsed( &start);
+
+	printf( "full copy\t%.3f sec\t%ld words copied\n", t_copy, num_clone);
+
+	// snapshots must not see later updates
+	for (int c = 0; c < num_checkpoint; c++)
+	{
+		long sum, copy_sum;
+
+		PAVLT_Traverse( snapshot[c], check_word);
+		sum = check_result();
+
+		AVLT_Traverse( copy[c], check_word);
+		copy_sum = check_result();
+
+		if (sum != counted[c] || copy_sum != counted[c] || PAVLT_Count( snapshot[c]) != AVLT_Count( copy[c]))
+		{
+			fprintf( stderr, "Error: checkpoint %d : freq sum %ld, %ld (expected %ld)\n",
+				c, sum, copy_sum, counted[c]);
+			errors++;
+		}
+	}
+
+	// versions are independent : deleting from the newest leaves older ones intact
+	for (int i = 0; i < num_tokens; i++)
+	{
+		tWord key = { tokens[i], 0};
+		PAVLT_Delete( ptree, &key, destroyWord);
+	}
+	PAVLT_Traverse( snapshot[num_checkpoint - 1], check_word);
+	checksum = check_result();
+	if (PAVLT_Count( ptree) != 0 || checksum != num_tokens)
+	{
+		fprintf( stderr, "Error: after delete : %d words, freq sum %ld\n", PAVLT_Count( ptree), checksum);
+		errors++;
+	}
+	if (!errors) printf( "snapshots checked\n");
+
+	PAVLT_Destroy( ptree, destroyWord);
+	AVLT_Destroy( tree, destroyWord);
+	for (int c = 0; c < num_checkpoint; c++)
+	{
+		PAVLT_Destroy( snapshot[c], destroyWord);
+		AVLT_Destroy( copy[c], destroyWord);
+	}
+
+	free_tokens( tokens, num_tokens);
+
+	return errors ? 1 : 0;
+}
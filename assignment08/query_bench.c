@@ -0,0 +1,74 @@
+#include <stdio.h>
+#include <stdlib.h> // atoi
+#include <time.h> // clock_gettime
+
+// replays the words of FILE as a query stream against one tree backend
+// the same program is linked with avlt.o (query_bench), splay.o (query_bench_s)
+// and built with -DUSE_BST against ../assignment06/bst.c (query_bench_b)
+// usage: query_bench FILE [repeat]
+
+#include "bench_tree.h"
+#include "bench_util.h"
+
+////////////////////////////////////////////////////////////////////////////////
+int main( int argc, char **argv)
+{
+	char **tokens;
+	int num_tokens;
+	int repeat = 5;
+	long found = 0;
+	double t_build, t_query;
+	struct timespec start;
+	TREE *tree;
+
+	if (argc != 2 && argc != 3) {
+		fprintf( stderr, "usage: %s FILE [repeat]\n", argv[0]);
+		return 1;
+	}
+	if (argc == 3) repeat = atoi( argv[2]);
+
+	num_tokens = read_file( argv[1], &tokens);
+	if (num_tokens < 0)
+	{
+		fprintf( stderr, "Error: cannot open file [%s]\n", argv[1]);
+		return 2;
+	}
+
+	tree = TREE_Create( compare_by_word);
+	if (!tree)
+	{
+		printf( "Cannot create a tree\n");
+		return 100;
+	}
+
+	clock_gettime( CLOCK_MONOTONIC, &start);
+	for (int i = 0; i < num_tokens; i++)
+	{
+		tWord *pWord = createWord( tokens[i]);
+		int ret = TREE_Insert( tree, pWord, increase_freq);
+		if (ret == 0 || ret == 2) destroyWord( pWord);
+	}
+	t_build = elapsed( &start);
+
+	// query stream : the words in file order (skewed like the text itself)
+	clock_gettime( CLOCK_MONOTONIC, &start);
+	for (int r = 0; r < repeat; r++)
+	{
+		for (int i = 0; i < num_tokens; i++)
+		{
+			tWord key = { tokens[i], 0};
+			found += (TREE_Search( tree, &key) != NULL);
+		}
+	}
+	t_query = elapsed( &start);
+
+	printf( "%s\t%s\t%d words\tbuild %.3f sec\tquery %.3f sec\t%.2f Mqueries/s\t%ld found\n",
+		argv[0], argv[1], TREE_Count( tree), t_build, t_query,
+		(double)num_tokens * repeat / t_query / 1e6, found);
+	TREE_Stats( stderr); // -DSTATS : compares and rotations of build and queries
+
+	TREE_Destroy( tree, destroyWord);
+	free_tokens( tokens, num_tokens);
+
+	return 0;
+}
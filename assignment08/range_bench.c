@@ -0,0 +1,176 @@
+#include <stdio.h>
+#include <stdlib.h> // malloc, free
+#include <string.h> // strcmp
+#include <time.h> // clock_gettime
+
+// range queries and range deletes on the words of FILE
+// query : words with each two-letter prefix ("ab" .. "ab\xff"), range traversal vs full traversal
+// delete : words from "?a" to "?m\xff" for each first letter, range delete vs deleting one by one
+// linked with avlt.o (range_bench) or built with -DUSE_BST against ../assignment06/bst.c (range_bench_b)
+// usage: range_bench FILE
+
+#include "bench_tree.h"
+#include "bench_util.h"
+
+////////////////////////////////////////////////////////////////////////////////
+static TREE *build( char **tokens, int num_tokens)
+{
+	TREE *tree = TREE_Create( compare_by_word);
+
+	for (int i = 0; tree && i < num_tokens; i++)
+	{
+		tWord *pWord = createWord( tokens[i]);
+		int ret = TREE_Insert( tree, pWord, increase_freq);
+		if (ret == 0 || ret == 2) destroyWord( pWord);
+	}
+	return tree;
+}
+
+// visited words : number and frequency sum
+static long num_words, sum_freq;
+static char *lo_word, *hi_word;
+
+void sum_word( const void *dataPtr)
+{
+	num_words++;
+	sum_freq += ((tWord *)dataPtr)->freq;
+}
+
+// full traversal : every word is checked against the range
+void sum_word_in_range( const void *dataPtr)
+{
+	const char *word = ((tWord *)dataPtr)->word;
+	if (strcmp( lo_word, word) <= 0 && strcmp( word, hi_word) <= 0) sum_word( dataPtr);
+}
+
+// one by one delete : words of the range collected first
+static tWord **range;
+static int num_range;
+
+void collect_word( const void *dataPtr)
+{
+	range[num_range++] = (tWord *)dataPtr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int main( int argc, char **argv)
+{
+	char lo[4], hi[4];
+	char **tokens;
+	int num_tokens, errors = 0;
+	long n1, s1, n2, s2;
+	double t1, t2;
+	struct timespec start;
+	tWord lo_key = { lo, 0}, hi_key = { hi, 0};
+	TREE *tree, *tree2;
+
+	if (argc != 2) {
+		fprintf( stderr, "usage: %s FILE\n", argv[0]);
+		return 1;
+	}
+
+	num_tokens = read_file( argv[1], &tokens);
+	if (num_tokens < 0)
+	{
+		fprintf( stderr, "Error: cannot open file [%s]\n", argv[1]);
+		return 2;
+	}
+
+	tree = build( tokens, num_tokens);
+	tree2 = build( tokens, num_tokens);
+	if (!tree || !tree2)
+	{
+		printf( "Cannot create a tree\n");
+		return 100;
+	}
+	lo_word = lo;
+	hi_word = hi;
+
+	// range queries : 26 * 26 prefixes
+	num_words = sum_freq = 0;
+	clock_gettime( CLOCK_MONOTONIC, &start);
+	for (int c1 = 'a'; c1 <= 'z'; c1++)
+		for (int c2 = 'a'; c2 <= 'z'; c2++)
+		{
+			sprintf( lo, "%c%c", c1, c2);
+			sprintf( hi, "%c%c\xff", c1, c2);
+			TREE_RangeTraverse( tree, &lo_key, &hi_key, sum_word);
+		}
+	t1 = elapsed( &start);
+	n1 = num_words; s1 = sum_freq;
+
+	num_words = sum_freq = 0;
+	clock_gettime( CLOCK_MONOTONIC, &start);
+	for (int c1 = 'a'; c1 <= 'z'; c1++)
+		for (int c2 = 'a'; c2 <= 'z'; c2++)
+		{
+			sprintf( lo, "%c%c", c1, c2);
+			sprintf( hi, "%c%c\xff", c1, c2);
+			TREE_Traverse( tree, sum_word_in_range);
+		}
+	t2 = elapsed( &start);
+	n2 = num_words; s2 = sum_freq;
+
+	printf( "%s\t%d words\n", argv[0], TREE_Count( tree));
+	printf( "676 range queries\trange %.2f ms\tfull %.2f ms\t%ld words\tfreq sum %ld\n",
+		t1 * 1e3, t2 * 1e3, n1, s1);
+	if (n1 != n2 || s1 != s2)
+	{
+		fprintf( stderr, "Error: range %ld words %ld, full %ld words %ld\n", n1, s1, n2, s2);
+		errors++;
+	}
+
+	// range deletes : "?a" .. "?m\xff"
+	n1 = 0;
+	clock_gettime( CLOCK_MONOTONIC, &start);
+	for (int c1 = 'a'; c1 <= 'z'; c1++)
+	{
+		sprintf( lo, "%ca", c1);
+		sprintf( hi, "%cm\xff", c1);
+		n1 += TREE_DeleteRange( tree, &lo_key, &hi_key, destroyWord);
+	}
+	t1 = elapsed( &start);
+
+	n2 = 0;
+	range = (tWord **)malloc( TREE_Count( tree2) * sizeof(tWord *));
+	clock_gettime( CLOCK_MONOTONIC, &start);
+	for (int c1 = 'a'; c1 <= 'z'; c1++)
+	{
+		sprintf( lo, "%ca", c1);
+		sprintf( hi, "%cm\xff", c1);
+		num_range = 0;
+		TREE_RangeTraverse( tree2, &lo_key, &hi_key, collect_word);
+		for (int i = 0; i < num_range; i++)
+		{
+			tWord *pWord = (tWord *)TREE_Delete( tree2, range[i]);
+			if (pWord)
+			{
+				destroyWord( pWord);
+				n2++;
+			}
+		}
+	}
+	t2 = elapsed( &start);
+	free( range);
+
+	num_words = sum_freq = 0;
+	TREE_Traverse( tree, sum_word);
+	s1 = sum_freq;
+	num_words = sum_freq = 0;
+	TREE_Traverse( tree2, sum_word);
+	s2 = sum_freq;
+
+	printf( "26 range deletes\trange %.2f ms\tone by one %.2f ms\t%ld deleted\t%d words left\tfreq sum %ld\n",
+		t1 * 1e3, t2 * 1e3, n1, TREE_Count( tree), s1);
+	if (n1 != n2 || s1 != s2 || TREE_Count( tree) != TREE_Count( tree2) || num_words != TREE_Count( tree))
+	{
+		fprintf( stderr, "Error: range %ld deleted (sum %ld), one by one %ld deleted (sum %ld)\n", n1, s1, n2, s2);
+		errors++;
+	}
+
+	TREE_Destroy( tree, destroyWord);
+	TREE_Destroy( tree2, destroyWord);
+	free_tokens( tokens, num_tokens);
+
+	return errors ? 1 : 0;
+}
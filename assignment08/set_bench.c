@@ -0,0 +1,171 @@
+#include <stdio.h>
+#include <stdlib.h> // atoi
+#include <time.h> // clock_gettime
+
+#include "avlt.h"
+#include "bench_util.h"
+
+// join-based set operations on two word dictionaries
+// dictionary A : tokens [0, split), dictionary B : tokens [split, n) of FILE
+// AVLT_Union / AVLT_Intersect / AVLT_Difference on 1, 2, 4, ... threads
+// vs inserting (or searching) every word of B into A one by one
+// the results are checked against AVLT_Search on fresh copies
+// usage: set_bench FILE [percent of tokens in A] [max threads]
+
+////////////////////////////////////////////////////////////////////////////////
+// for set operations : frequencies are summed
+int sum_freq( void *dataPtr, void *dataPtr2)
+{
+	((tWord *)dataPtr)->freq += ((tWord *)dataPtr2)->freq;
+	return 1;
+}
+
+static TREE *build( char **tokens, int from, int to)
+{
+	TREE *tree = AVLT_Create( compare_by_word);
+
+	for (int i = from; tree && i < to; i++)
+	{
+		tWord *pWord = createWord( tokens[i]);
+		int ret = AVLT_Insert( tree, pWord, increase_freq);
+		if (ret == 0 || ret == 2) destroyWord( pWord);
+	}
+	return tree;
+}
+
+// return	height if AVL, -1 otherwise
+static int check_avl( NODE *root)
+{
+	int lh, rh;
+
+	if (!root) return 0;
+	lh = check_avl( root->left);
+	rh = check_avl( root->right);
+	if (lh < 0 || rh < 0 || lh - rh > 1 || rh - lh > 1) return -1;
+	if (root->height != 1 + (lh > rh ? lh : rh)) return -1;
+	return root->height;
+}
+
+static long check( TREE *tree)
+{
+	AVLT_Traverse( tree, check_word);
+	return check_result();
+}
+
+// one by one (baseline) : every word of B into A
+static TREE *target;
+static long expected_words[3], expected_sum[3]; // UNION, INTERSECT, DIFFERENCE
+
+void insert_word( const void *dataPtr)
+{
+	tWord *pWord = (tWord *)dataPtr;
+	tWord *found = (tWord *)AVLT_Search( target, pWord);
+
+	if (found) found->freq += pWord->freq;
+	else
+	{
+		tWord *newWord = createWord( pWord->word);
+		newWord->freq = pWord->freq;
+		AVLT_Insert( target, newWord, NULL);
+	}
+}
+
+void expect_word( const void *dataPtr)
+{
+	tWord *pWord = (tWord *)dataPtr;
+	tWord *found = (tWord *)AVLT_Search( target, pWord);
+
+	if (found)
+	{
+		expected_words[1]++;
+		expected_sum[1] += pWord->freq + found->freq;
+		expected_words[2]--;
+		expected_sum[2] -= found->freq;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int main( int argc, char **argv)
+{
+	char **tokens;
+	int num_tokens;
+	int percent = 50, max_thread = 4, split, errors = 0;
+	const char *name[3] = { "union", "intersect", "difference"};
+	void (*op[3])( TREE *, TREE *, int (*)(void *, void *), void (*)(void *), int) =
+		{ AVLT_Union, AVLT_Intersect, AVLT_Difference};
+	int (*merge[3])(void *, void *) = { sum_freq, sum_freq, NULL};
+	struct timespec start;
+	TREE *a, *b;
+
+	if (argc < 2 || argc > 4) {
+		fprintf( stderr, "usage: %s FILE [percent of tokens in A] [max threads]\n", argv[0]);
+		return 1;
+	}
+	if (argc >= 3) percent = atoi( argv[2]);
+	if (argc == 4) max_thread = atoi( argv[3]);
+	if (percent < 0 || percent > 100 || max_thread < 1)
+	{
+		fprintf( stderr, "Error: percent must be 0 .. 100, threads at least 1\n");
+		return 1;
+	}
+
+	num_tokens = read_file( argv[1], &tokens);
+	if (num_tokens < 0)
+	{
+		fprintf( stderr, "Error: cannot open file [%s]\n", argv[1]);
+		return 2;
+	}
+
+	split = (int)((long)num_tokens * percent / 100);
+
+	// expected results
+	a = build( tokens, 0, split);
+	b = build( tokens, split, num_tokens);
+	target = a;
+	expected_words[2] = AVLT_Count( a);
+	expected_sum[2] = check( a);
+	AVLT_Traverse( b, expect_word);
+	expected_words[0] = AVLT_Count( a) + AVLT_Count( b) - expected_words[1];
+	expected_sum[0] = num_tokens;
+
+	printf( "A %d words, B %d words\n", AVLT_Count( a), AVLT_Count( b));
+
+	// baseline : union by searching and inserting every word of B
+	clock_gettime( CLOCK_MONOTONIC, &start);
+	AVLT_Traverse( b, insert_word);
+	printf( "one by one\tunion\t%.2f ms\n", elapsed( &start) * 1e3);
+	AVLT_Destroy( a, destroyWord);
+	AVLT_Destroy( b, destroyWord);
+
+	for (int k = 0; k < 3; k++)
+	{
+		for (int num_thread = 1; num_thread <= max_thread; num_thread *= 2)
+		{
+			double t;
+			long sum;
+
+			a = build( tokens, 0, split);
+			b = build( tokens, split, num_tokens);
+
+			clock_gettime( CLOCK_MONOTONIC, &start);
+			op[k]( a, b, merge[k], destroyWord, num_thread);
+			t = elapsed( &start);
+
+			sum = check( a);
+			printf( "%d threads\t%s\t%.2f ms\t%d words\theight %d\tfreq sum %ld\n",
+				num_thread, name[k], t * 1e3, AVLT_Count( a), check_avl( a->root), sum);
+
+			if (AVLT_Count( a) != expected_words[k] || sum != expected_sum[k] || check_avl( a->root) < 0)
+			{
+				fprintf( stderr, "Error: %s : expected %ld words, freq sum %ld\n",
+					name[k], expected_words[k], expected_sum[k]);
+				errors++;
+			}
+			AVLT_Destroy( a, destroyWord);
+		}
+	}
+
+	free_tokens( tokens, num_tokens);
+
+	return errors ? 1 : 0;
+}
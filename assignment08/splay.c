@@ -0,0 +1,384 @@
+#include <stdlib.h> // malloc
+#include <stdio.h>
+
+#include "avlt.h"
+
+// splay tree (top-down splay, Sleator and Tarjan)
+// the same functions as avlt.c : every access moves the node to the root,
+// so frequently used words stay near the root (amortized O(log n))
+// height field of NODE is not used; AVLT_Height computes the height
+// traversal and destroy are iterative because a splay tree can be a long path
+
+// internal functions
+static int _compare( TREE *pTree, NODE *a, NODE *b);
+static void _setKey( TREE *pTree, NODE *node, void *dataPtr);
+static NODE *_splay( TREE *pTree, NODE *keyNode, NODE *root);
+static void _destroy( NODE *root, void (*callback)(void *), NODE **pool);
+static void _inorder_print( NODE *root, int count, void (*callback)(const void *));
+
+// statistics (-DSTATS), see AVLT_Stats
+#ifdef STATS
+static struct {
+    long compare;       // compare calls
+    long abbrev;        // comparisons decided by abbreviated keys
+    long visit;         // nodes compared while splaying
+    long rotate_left;   // zig-zig rotations
+    long rotate_right;
+    long malloc_bytes;  // nodes allocated
+    long reuse;         // nodes taken from the pool
+} stats;
+#define STAT(x)     (x)
+#else
+#define STAT(x)     ((void)0)
+#endif
+
+
+TREE *AVLT_Create( int (*compare)(const void *, const void *)) {
+    return AVLT_CreateAbbrev(compare, NULL);
+}
+
+TREE *AVLT_CreateAbbrev( int (*compare)(const void *, const void *), int (*abbrev)(const void *, unsigned long long *)) {
+    TREE *tree = (TREE *)malloc(sizeof(TREE));
+    if (tree) {
+        tree->root = NULL;
+        tree->count = 0;
+        tree->compare = compare;
+        tree->abbrev = abbrev;
+        tree->pool = NULL;
+    }
+    return tree;
+}
+
+void AVLT_Destroy( TREE *pTree, void (*callback)(void *)) {
+    if (pTree) {
+        _destroy(pTree->root, callback, NULL);
+        while (pTree->pool) {
+            NODE *node = pTree->pool;
+            pTree->pool = node->right;
+            free(node);
+        }
+        free(pTree);
+    }
+}
+
+void AVLT_Clear( TREE *pTree, void (*callback)(void *)) {
+    _destroy(pTree->root, callback, &pTree->pool);
+    pTree->root = NULL;
+    pTree->count = 0;
+}
+
+int AVLT_Insert( TREE *pTree, void *dataInPtr, void (*callback)(void *)) {
+    NODE *newNode = pTree->pool; // a node kept by AVLT_Clear is used first
+    if (newNode) {
+        pTree->pool = newNode->right;
+        STAT(stats.reuse++);
+    } else {
+        newNode = (NODE *)malloc(sizeof(NODE));
+        STAT(stats.malloc_bytes += sizeof(NODE));
+    }
+    if (!newNode)
+        return 0;
+
+    _setKey(pTree, newNode, dataInPtr);
+    newNode->left = newNode->right = NULL;
+    newNode->height = 1;
+
+    if (pTree->root) {
+        pTree->root = _splay(pTree, newNode, pTree->root);
+
+        int cmp = _compare(pTree, newNode, pTree->root);
+        if (cmp == 0) {
+            if (callback)
+                callback(pTree->root->dataPtr);
+            newNode->right = pTree->pool; // back to the pool for the next insert
+            pTree->pool = newNode;
+            return 2;
+        }
+        if (cmp < 0) {
+            newNode->left = pTree->root->left;
+            newNode->right = pTree->root;
+            pTree->root->left = NULL;
+        } else {
+            newNode->right = pTree->root->right;
+            newNode->left = pTree->root;
+            pTree->root->right = NULL;
+        }
+    }
+    pTree->root = newNode;
+    pTree->count++;
+    return 1;
+}
+
+void *AVLT_Delete( TREE *pTree, void *keyPtr) {
+    NODE keyNode;
+    NODE *root;
+    void *dataOutPtr;
+
+    if (!pTree->root)
+        return NULL;
+
+    _setKey(pTree, &keyNode, keyPtr);
+    root = pTree->root = _splay(pTree, &keyNode, pTree->root);
+    if (_compare(pTree, &keyNode, root) != 0)
+        return NULL;
+
+    dataOutPtr = root->dataPtr;
+    if (!root->left) {
+        pTree->root = root->right;
+    } else {
+        // the largest node of the left subtree becomes the root (it has no right child)
+        pTree->root = _splay(pTree, &keyNode, root->left);
+        pTree->root->right = root->right;
+    }
+    free(root);
+    pTree->count--;
+    return dataOutPtr;
+}
+
+void *AVLT_Search( TREE *pTree, void *keyPtr) {
+    NODE keyNode;
+
+    if (!pTree->root)
+        return NULL;
+
+    _setKey(pTree, &keyNode, keyPtr);
+    pTree->root = _splay(pTree, &keyNode, pTree->root);
+    return (_compare(pTree, &keyNode, pTree->root) == 0) ? pTree->root->dataPtr : NULL;
+}
+
+// Morris traversal (threads through right links, restored on the way)
+void AVLT_Traverse( TREE *pTree, void (*callback)(const void *)) {
+    NODE *root = pTree->root;
+
+    while (root) {
+        if (!root->left) {
+            callback(root->dataPtr);
+            root = root->right;
+        } else {
+            NODE *pre = root->left;
+            while (pre->right && pre->right != root)
+                pre = pre->right;
+            if (!pre->right) {
+                pre->right = root;
+                root = root->left;
+            } else {
+                pre->right = NULL;
+                callback(root->dataPtr);
+                root = root->right;
+            }
+        }
+    }
+}
+
+// Morris traversal (mirror)
+void AVLT_TraverseR( TREE *pTree, void (*callback)(const void *)) {
+    NODE *root = pTree->root;
+
+    while (root) {
+        if (!root->right) {
+            callback(root->dataPtr);
+            root = root->left;
+        } else {
+            NODE *pre = root->right;
+            while (pre->left && pre->left != root)
+                pre = pre->left;
+            if (!pre->left) {
+                pre->left = root;
+                root = root->right;
+            } else {
+                pre->left = NULL;
+                callback(root->dataPtr);
+                root = root->left;
+            }
+        }
+    }
+}
+
+void printTree( TREE *pTree, void (*callback)(const void *)) {
+    _inorder_print(pTree->root, pTree->count, callback);
+}
+
+int AVLT_Count( TREE *pTree) {
+    return pTree->count;
+}
+
+// level order with a queue of all nodes
+// return	height
+//			-1 if overflow
+int AVLT_Height( TREE *pTree) {
+    NODE **queue;
+    int front = 0, rear = 0, height = 0;
+
+    if (!pTree->root)
+        return 0;
+
+    queue = (NODE **)malloc(pTree->count * sizeof(NODE *));
+    if (!queue)
+        return -1;
+
+    queue[rear++] = pTree->root;
+    while (front < rear) {
+        int end = rear; // nodes of the current level : front .. end-1
+        height++;
+        while (front < end) {
+            NODE *node = queue[front++];
+            if (node->left)
+                queue[rear++] = node->left;
+            if (node->right)
+                queue[rear++] = node->right;
+        }
+    }
+    free(queue);
+    return height;
+}
+
+void AVLT_Stats( FILE *fp) {
+#ifdef STATS
+    fprintf(fp, "{\"adt\": \"splay\", \"compare\": %ld, \"abbrev\": %ld, \"visit\": %ld, "
+        "\"rotate_left\": %ld, \"rotate_right\": %ld, \"malloc_bytes\": %ld, \"reuse\": %ld}\n",
+        stats.compare, stats.abbrev, stats.visit,
+        stats.rotate_left, stats.rotate_right, stats.malloc_bytes, stats.reuse);
+#else
+    (void)fp;
+#endif
+}
+
+
+
+// compares data of two nodes
+// abbreviated keys decide unless they are equal (compare is not called)
+static int _compare( TREE *pTree, NODE *a, NODE *b) {
+    STAT(stats.visit++);
+    if (pTree->abbrev) {
+        if (a->key != b->key)
+            return (STAT(stats.abbrev++), (a->key < b->key) ? -1 : 1);
+        if (a->key_full && b->key_full)
+            return (STAT(stats.abbrev++), 0);
+    }
+    STAT(stats.compare++);
+    return pTree->compare(a->dataPtr, b->dataPtr);
+}
+
+// stores data and its abbreviated key into node
+static void _setKey( TREE *pTree, NODE *node, void *dataPtr) {
+    node->dataPtr = dataPtr;
+    node->key = 0;
+    node->key_full = 0;
+    if (pTree->abbrev)
+        node->key_full = pTree->abbrev(dataPtr, &node->key);
+}
+
+// top-down splay
+// moves the node with the key (or the last node on its search path) to the root
+// return	new root
+static NODE *_splay( TREE *pTree, NODE *keyNode, NODE *root) {
+    NODE header; // header.right : left tree, header.left : right tree
+    NODE *leftMax = &header, *rightMin = &header;
+
+    header.left = header.right = NULL;
+
+    while (1) {
+        int cmp = _compare(pTree, keyNode, root);
+        if (cmp < 0) {
+            if (!root->left)
+                break;
+            if (_compare(pTree, keyNode, root->left) < 0) { // zig-zig : rotate right
+                NODE *temp = root->left;
+                STAT(stats.rotate_right++);
+                root->left = temp->right;
+                temp->right = root;
+                root = temp;
+                if (!root->left)
+                    break;
+            }
+            rightMin->left = root; // link right
+            rightMin = root;
+            root = root->left;
+        } else if (cmp > 0) {
+            if (!root->right)
+                break;
+            if (_compare(pTree, keyNode, root->right) > 0) { // zig-zig : rotate left
+                NODE *temp = root->right;
+                STAT(stats.rotate_left++);
+                root->right = temp->left;
+                temp->left = root;
+                root = temp;
+                if (!root->right)
+                    break;
+            }
+            leftMax->right = root; // link left
+            leftMax = root;
+            root = root->right;
+        } else {
+            break;
+        }
+    }
+
+    // assemble
+    leftMax->right = root->left;
+    rightMin->left = root->right;
+    root->left = header.right;
+    root->right = header.left;
+    return root;
+}
+
+// used in AVLT_Destroy, AVLT_Clear
+// rotates left children up, so the node to free never has a left child
+// nodes are freed (pool NULL) or kept in *pool
+static void _destroy( NODE *root, void (*callback)(void *), NODE **pool) {
+    while (root) {
+        if (root->left) {
+            NODE *temp = root->left;
+            root->left = temp->right;
+            temp->right = root;
+            root = temp;
+        } else {
+            NODE *temp = root->right;
+            callback(root->dataPtr);
+            if (pool) {
+                root->right = *pool;
+                *pool = root;
+            } else {
+                free(root);
+            }
+            root = temp;
+        }
+    }
+}
+
+// used in printTree
+// right subtree, node, left subtree with an explicit stack of nodes and their levels
+// count (number of nodes) bounds the depth
+static void _inorder_print( NODE *root, int count, void (*callback)(const void *)){
+    NODE **stack;
+    int *levels;
+    int top = 0, level = 0;
+
+    if (!root)
+        return;
+
+    stack = (NODE **)malloc(count * sizeof(NODE *));
+    levels = (int *)malloc(count * sizeof(int));
+    if (!stack || !levels) {
+        free(stack);
+        free(levels);
+        return;
+    }
+
+    while (root || top > 0) {
+        while (root) {
+            stack[top] = root;
+            levels[top++] = level++;
+            root = root->right;
+        }
+        root = stack[--top];
+        level = levels[top];
+        for (int i = 0; i < level; i++)
+            printf("\t");
+        callback(root->dataPtr);
+        root = root->left;
+        level++;
+    }
+    free(stack);
+    free(levels);
+}
@@ -0,0 +1,101 @@
+#include <stdio.h>
+#include <stdlib.h> // malloc, free, atoi
+#include <string.h> // strdup
+#include <time.h> // clock_gettime
+
+// building and tearing down a large dictionary
+// keys : the tokens of FILE with a copy number ("word#3"), repeated until about N keys
+// build, destroy / build, clear, build again (nodes reused), destroy
+// linked with avlt.o (teardown_bench), splay.o (teardown_bench_s)
+// or built with -DUSE_BST against ../assignment06/bst.c (teardown_bench_b)
+// usage: teardown_bench FILE [N]
+
+#include "bench_tree.h"
+#include "bench_util.h"
+
+////////////////////////////////////////////////////////////////////////////////
+static void build( TREE *tree, char **keys, int num_keys)
+{
+	for (int i = 0; i < num_keys; i++)
+	{
+		tWord *pWord = createWord( keys[i]);
+		int ret = TREE_Insert( tree, pWord, increase_freq);
+		if (ret == 0 || ret == 2) destroyWord( pWord);
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int main( int argc, char **argv)
+{
+	char key[120];
+	char **tokens, **keys;
+	int num_tokens, num_keys, n = 1000000;
+	double t_build, t_destroy, t_clear, t_rebuild, t_destroy2;
+	struct timespec start;
+	TREE *tree;
+
+	if (argc != 2 && argc != 3) {
+		fprintf( stderr, "usage: %s FILE [N]\n", argv[0]);
+		return 1;
+	}
+	if (argc == 3) n = atoi( argv[2]);
+
+	num_tokens = read_file( argv[1], &tokens);
+	if (num_tokens < 0)
+	{
+		fprintf( stderr, "Error: cannot open file [%s]\n", argv[1]);
+		return 2;
+	}
+
+	if (num_tokens == 0 || n < 1) return 0;
+
+	num_keys = n;
+	keys = (char **)malloc( num_keys * sizeof(char *));
+	for (int i = 0; i < num_keys; i++)
+	{
+		sprintf( key, "%s#%d", tokens[i % num_tokens], i / num_tokens);
+		keys[i] = strdup( key);
+	}
+
+	tree = TREE_Create( compare_by_word);
+	if (!tree)
+	{
+		printf( "Cannot create a tree\n");
+		return 100;
+	}
+
+	clock_gettime( CLOCK_MONOTONIC, &start);
+	build( tree, keys, num_keys);
+	t_build = elapsed( &start);
+
+	printf( "%s\t%d keys\n", argv[0], TREE_Count( tree));
+
+	clock_gettime( CLOCK_MONOTONIC, &start);
+	TREE_Destroy( tree, destroyWord);
+	t_destroy = elapsed( &start);
+
+	// clear and build again
+	tree = TREE_Create( compare_by_word);
+	build( tree, keys, num_keys);
+
+	clock_gettime( CLOCK_MONOTONIC, &start);
+	TREE_Clear( tree, destroyWord);
+	t_clear = elapsed( &start);
+
+	clock_gettime( CLOCK_MONOTONIC, &start);
+	build( tree, keys, num_keys);
+	t_rebuild = elapsed( &start);
+
+	clock_gettime( CLOCK_MONOTONIC, &start);
+	TREE_Destroy( tree, destroyWord);
+	t_destroy2 = elapsed( &start);
+
+	printf( "build %.3f sec\tdestroy %.3f sec\tclear %.3f sec\tbuild after clear %.3f sec\tdestroy %.3f sec\n",
+		t_build, t_destroy, t_clear, t_rebuild, t_destroy2);
+
+	for (int i = 0; i < num_keys; i++) free( keys[i]);
+	free( keys);
+	free_tokens( tokens, num_tokens);
+
+	return 0;
+}
@@ -0,0 +1,154 @@
+#include <stdio.h>
+#include <stdlib.h> // free
+#include <string.h> // strdup, strcmp
+#include <time.h> // clock_gettime
+
+#include "avlt.h"
+#include "avlt_tmpl.h"
+#include "bench_util.h"
+
+// generic AVL tree (avlt.c : void *, compare through a function pointer, tWord allocated per node)
+// vs type-specialised AVL tree (avlt_tmpl.h : tWord stored in the node, inlined compare)
+// on the word_count7 workload : count words of FILE, search every word, traverse
+// usage: tree_bench FILE
+
+////////////////////////////////////////////////////////////////////////////////
+// for AVLT_CreateAbbrev function (word_count7.c)
+int abbrev_word( const void *n, unsigned long long *key)
+{
+	const unsigned char *p = (const unsigned char *)((tWord *)n)->word;
+	unsigned long long k = 0;
+	int len = 0;
+
+	for (int i = 0; i < 8; i++)
+	{
+		k <<= 8;
+		if (len == i && p[i] != '\0')
+		{
+			k |= p[i];
+			len++;
+		}
+	}
+	*key = k;
+	return len < 8;
+}
+
+// for AVLT_DEFINE (inlined)
+static inline int compare_word( const tWord *p1, const tWord *p2)
+{
+	return strcmp( p1->word, p2->word);
+}
+
+AVLT_DEFINE( tWord, compare_word)
+
+static void free_word( tWord *pWord)
+{
+	free( pWord->word);
+}
+
+// for AVLT_Traverse_tWord : the same check as the generic tree (bench_util.c)
+static void check_typed( const tWord *pWord)
+{
+	check_word( pWord);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// generic tree (abbrev NULL : AVLT_Create)
+static void bench_generic( const char *name, char **tokens, int num_tokens,
+	int (*abbrev)(const void *, unsigned long long *))
+{
+	struct timespec start;
+	double t_insert, t_search;
+	int found = 0;
+	TREE *tree = abbrev ? AVLT_CreateAbbrev( compare_by_word, abbrev) : AVLT_Create( compare_by_word);
+
+	if (!tree) return;
+
+	clock_gettime( CLOCK_MONOTONIC, &start);
+	for (int i = 0; i < num_tokens; i++)
+	{
+		tWord *pWord = createWord( tokens[i]);
+		int ret = AVLT_Insert( tree, pWord, increase_freq);
+		if (ret == 0 || ret == 2) destroyWord( pWord);
+	}
+	t_insert = elapsed( &start);
+
+	clock_gettime( CLOCK_MONOTONIC, &start);
+	for (int i = 0; i < num_tokens; i++)
+	{
+		tWord key = { tokens[i], 0};
+		found += (AVLT_Search( tree, &key) != NULL);
+	}
+	t_search = elapsed( &start);
+
+	AVLT_Traverse( tree, check_word);
+
+	printf( "%s\t%.3f sec\t%.3f sec\t%d\t%d\t%ld\n", name, t_insert, t_search,
+		AVLT_Count( tree), AVLT_Height( tree), check_result());
+
+	AVLT_Destroy( tree, destroyWord);
+}
+
+static void bench_typed( char **tokens, int num_tokens)
+{
+	struct timespec start;
+	double t_insert, t_search;
+	int found = 0;
+	AVLT(tWord) *tree = AVLT_Create_tWord();
+
+	if (!tree) return;
+
+	clock_gettime( CLOCK_MONOTONIC, &start);
+	for (int i = 0; i < num_tokens; i++)
+	{
+		tWord word = { tokens[i], 1};
+		tWord *stored;
+		int ret = AVLT_Insert_tWord( tree, word, &stored);
+		if (ret == 1) stored->word = strdup( tokens[i]); // the tree keeps its own copy
+		else if (ret == 2) stored->freq++;
+	}
+	t_insert = elapsed( &start);
+
+	clock_gettime( CLOCK_MONOTONIC, &start);
+	for (int i = 0; i < num_tokens; i++)
+	{
+		tWord key = { tokens[i], 0};
+		found += (AVLT_Search_tWord( tree, &key) != NULL);
+	}
+	t_search = elapsed( &start);
+
+	AVLT_Traverse_tWord( tree, check_typed);
+
+	printf( "AVLT(tWord)\t%.3f sec\t%.3f sec\t%d\t%d\t%ld\n", t_insert, t_search,
+		AVLT_Count_tWord( tree), AVLT_Height_tWord( tree), check_result());
+
+	AVLT_Destroy_tWord( tree, free_word);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int main( int argc, char **argv)
+{
+	char **tokens;
+	int num_tokens;
+
+	if (argc != 2) {
+		fprintf( stderr, "usage: %s FILE\n", argv[0]);
+		return 1;
+	}
+
+	num_tokens = read_file( argv[1], &tokens);
+	if (num_tokens < 0)
+	{
+		fprintf( stderr, "Error: cannot open file [%s]\n", argv[1]);
+		return 2;
+	}
+
+	printf( "%d tokens\tinsert\t\tsearch\t\twords\theight\tchecksum\n", num_tokens);
+	bench_generic( "generic\t", tokens, num_tokens, NULL);
+	bench_generic( "generic+abbrev", tokens, num_tokens, abbrev_word);
+	bench_typed( tokens, num_tokens);
+
+	free_tokens( tokens, num_tokens);
+
+	return 0;
+}
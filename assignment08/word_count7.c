@@ -1,9 +1,14 @@
 #include <stdio.h>
-#include <stdlib.h> // malloc
-#include <string.h> // strdup, strcmp
+#include <stdlib.h> // malloc, atoi, atol
+#include <string.h> // strcmp
 #include <ctype.h> // toupper
+#include <signal.h> // signal, SIGUSR1
+#include <unistd.h> // getopt
 
 #include "avlt.h"
+#include "outbuf.h"
+#include "intern.h"
+#include "ssummary.h"
 
 #define QUIT			1
 #define FORWARD_PRINT	2
@@ -17,7 +22,7 @@
 // User structure type definition
 // 단어 구조체
 typedef struct {
-	char	*word;		// 단어
+	STR		word;		// 단어 (intern pool handle)
 	int		freq;		// 빈도
 } tWord;
 
@@ -25,9 +30,9 @@ typedef struct {
 // 단어 구조체를 위한 메모리를 할당하고 word, freq 초기화
 // return	할당된 단어 구조체에 대한 pointer
 //			NULL if overflow
-tWord *createWord( char *word);
+tWord *createWord( STR word);
 
-// 단어 구조체에 할당된 메모리를 해제
+// 단어 구조체에 할당된 메모리를 해제 (the word stays in the intern pool)
 // for destroyList function
 void destroyWord( void *pNode);
 
@@ -63,26 +68,55 @@ int get_action()
 // compares two words in word structures
 // for AVLT_Create function
 // 정렬 기준 : 단어
+// equal words have equal handles, strcmp only orders different words
 int compare_by_word( const void *n1, const void *n2)
 {
 	tWord *p1 = (tWord *)n1;
 	tWord *p2 = (tWord *)n2;
 	
-	return strcmp( p1->word, p2->word);
+	if (p1->word == p2->word) return 0;
+	return strcmp( intern_str( p1->word), intern_str( p2->word));
+}
+
+// abbreviated key of a word : first 8 bytes packed big-endian (the same order as strcmp)
+// for AVLT_CreateAbbrev function
+// return	1 if the word is shorter than 8 bytes (key holds the whole word)
+//			0 otherwise
+int abbrev_word( const void *n, unsigned long long *key)
+{
+	const unsigned char *p = (const unsigned char *)intern_str( ((tWord *)n)->word);
+	unsigned long long k = 0;
+	int len = 0;
+
+	for (int i = 0; i < 8; i++)
+	{
+		k <<= 8;
+		if (len == i && p[i] != '\0')
+		{
+			k |= p[i];
+			len++;
+		}
+	}
+	*key = k;
+	return len < 8;
 }
 
 // prints contents of word structure
 // for AVLT_Traverse and AVLT_TraverseR functions
+// buffered (outbuf), out_flush after the traversal
 void print_word(const void *dataPtr)
 {
-	printf( "%s\t%d\n", ((tWord *)dataPtr)->word, ((tWord *)dataPtr)->freq);
+	out_str( intern_str( ((tWord *)dataPtr)->word));
+	out_char( '\t');
+	out_int( ((tWord *)dataPtr)->freq);
+	out_char( '\n');
 }
 
 // prints word of word structure
 // for printTree function
 void print_word_only(const void *dataPtr)
 {
-	printf( "%s\n", ((tWord *)dataPtr)->word);
+	printf( "%s\n", intern_str( ((tWord *)dataPtr)->word));
 }
 
 void increase_freq(void *dataPtr)
@@ -97,30 +131,110 @@ void input_word(char *word)
 	fscanf( stdin, "%s", word);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// streaming mode (-s K) : top-K words of an unbounded stream in K counters (Space-Saving)
+// the top-K so far is printed every interval tokens (-n), on SIGUSR1 and at EOF
+// word, count, error (count - error <= frequency <= count)
+static volatile sig_atomic_t query;
+
+static void on_query( int sig)
+{
+	(void)sig;
+	query = 1;
+}
+
+static void print_top( SSUMMARY *ss, SSCOUNTER **list)
+{
+	int num = ss_List( ss, list, ss->k);
+
+	out_str( "# ");
+	out_int( ss->total);
+	out_str( " tokens\n");
+	for (int i = 0; i < num; i++)
+	{
+		out_str( list[i]->word);
+		out_char( '\t');
+		out_int( ss_Count( list[i]));
+		out_char( '\t');
+		out_int( list[i]->error);
+		out_char( '\n');
+	}
+	out_flush();
+}
+
+static int stream_count( FILE *fp, int k, long interval)
+{
+	char word[100];
+	SSUMMARY *ss = ss_Create( k);
+	SSCOUNTER **list = (SSCOUNTER **)malloc( (k > 0 ? k : 1) * sizeof(SSCOUNTER *));
+
+	if (!ss || !list)
+	{
+		fprintf( stderr, "Error: K must be at least 1 (or overflow)\n");
+		return 100;
+	}
+	signal( SIGUSR1, on_query);
+
+	while (fscanf( fp, "%99s", word) != EOF)
+	{
+		if (ss_Add( ss, word) == 0) fprintf( stderr, "Error: overflow [%s]\n", word);
+
+		if (query || (interval > 0 && ss->total % interval == 0))
+		{
+			query = 0;
+			print_top( ss, list);
+		}
+	}
+	print_top( ss, list);
+
+	free( list);
+	ss_Destroy( ss);
+	return 0;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 int main( int argc, char **argv)
 {
 	TREE *tree;
 	
 	char word[100];
-	tWord *pWord;
-	int ret;
+	tWord *pWord, key = { 0, 0};
+	int num_interned;
+	int ret, opt, k = 0;
+	long interval = 0;
 	FILE *fp;
 	
-	if (argc != 2) {
+	while ((opt = getopt( argc, argv, "s:n:")) != -1)
+	{
+		switch (opt)
+		{
+			case 's': if ((k = atoi( optarg)) < 1) optind = argc + 1; break;
+			case 'n': interval = atol( optarg); break;
+			default: optind = argc + 1; break;
+		}
+	}
+	if (optind != argc - 1 || (interval && !k)) {
 		fprintf( stderr, "usage: %s FILE\n", argv[0]);
+		fprintf( stderr, "       %s -s K [-n N] FILE|-\t(streaming top-K, every N tokens, on SIGUSR1 and at EOF)\n", argv[0]);
 		return 1;
 	}
 	
-	fp = fopen( argv[1], "rt");
+	fp = strcmp( argv[optind], "-") == 0 && k ? stdin : fopen( argv[optind], "rt");
 	if (!fp)
 	{
-		fprintf( stderr, "Error: cannot open file [%s]\n", argv[1]);
+		fprintf( stderr, "Error: cannot open file [%s]\n", argv[optind]);
 		return 2;
 	}
 	
+	if (k)
+	{
+		ret = stream_count( fp, k, interval);
+		fclose( fp);
+		return ret;
+	}
+	
 	// creates an empty tree
-	tree = AVLT_Create(compare_by_word);
+	tree = AVLT_CreateAbbrev(compare_by_word, abbrev_word);
 	if (!tree)
 	{
 		printf( "Cannot create a tree\n");
@@ -129,13 +243,24 @@ int main( int argc, char **argv)
 	
 	while(fscanf( fp, "%s", word) != EOF)
 	{
-		pWord = createWord( word);
+		// 이미 있는 단어는 메모리 할당 없이 빈도만 증가
+		// a word new to the pool is not in the tree (no search)
+		num_interned = intern_count();
+		key.word = intern( word);
+		
+		if (key.word && intern_count() == num_interned && (pWord = AVLT_Search( tree, &key)) != NULL)
+		{
+			pWord->freq++;
+			continue;
+		}
+		
+		pWord = key.word ? createWord( key.word) : NULL;
 		
-		ret = AVLT_Insert( tree, pWord, increase_freq);
+		ret = pWord ? AVLT_Insert( tree, pWord, increase_freq) : 0;
 		
 		if (ret == 0 || ret == 2) // failure or duplicated
 		{
-			destroyWord( pWord);
+			free( pWord);
 		}
 	}
 	
@@ -151,15 +276,19 @@ int main( int argc, char **argv)
 		switch( action)
 		{
 			case QUIT:
+				AVLT_Stats( stderr); // -DSTATS
 				AVLT_Destroy( tree, destroyWord);
+				intern_clear();
 				return 0;
 			
 			case FORWARD_PRINT:
 				AVLT_Traverse( tree, print_word);
+				out_flush();
 				break;
 			
 			case BACKWARD_PRINT:
 				AVLT_TraverseR( tree, print_word);
+				out_flush();
 				break;
 			
 			case TREE_PRINT:
@@ -169,27 +298,27 @@ int main( int argc, char **argv)
 			case SEARCH:
 				input_word(word);
 				
-				pWord = createWord( word);
+				key.word = intern_find( word); // 0 : never counted
 
-				if ((ptr = AVLT_Search( tree, pWord)) != NULL) print_word( ptr);
+				if (key.word && (ptr = AVLT_Search( tree, &key)) != NULL)
+				{
+					print_word( ptr);
+					out_flush();
+				}
 				else fprintf( stdout, "%s not found\n", word);
-				
-				destroyWord( pWord);
 				break;
 				
 			case DELETE:
 				input_word(word);
 				
-				pWord = createWord( word);
+				key.word = intern_find( word);
 
-				if ((ptr = AVLT_Delete( tree, pWord)) != NULL)
+				if (key.word && (ptr = AVLT_Delete( tree, &key)) != NULL)
 				{
-					fprintf( stdout, "(%s, %d) deleted\n", ((tWord *)ptr)->word, ((tWord *)ptr)->freq);
+					fprintf( stdout, "(%s, %d) deleted\n", intern_str( ((tWord *)ptr)->word), ((tWord *)ptr)->freq);
 					destroyWord( ptr);
 				}
 				else fprintf( stdout, "%s not found\n", word);
-				
-				destroyWord( pWord);
 				break;
 			
 			case COUNT:
@@ -247,13 +376,13 @@ int main( int argc, char **argv)
 
 
 ////////////////////////////////////////////////////////////////////////////////
-tWord *createWord( char *word)
+tWord *createWord( STR word)
 {
 	tWord *newWord = malloc( sizeof( tWord));
 	
 	if (newWord == NULL) return NULL;
 	
-	newWord->word = strdup( word);
+	newWord->word = word;
 	newWord->freq = 1;
 	
 	return newWord;
@@ -262,7 +391,6 @@ tWord *createWord( char *word)
 ////////////////////////////////////////////////////////////////////////////////
 void destroyWord( void *pWord)
 {
-	free( ((tWord *)pWord)->word);
 	free( pWord);
 }
 
@@ -3,12 +3,26 @@
 #include <string.h>	// strdup
 #include <ctype.h>	// isupper, tolower
 
+#include "outbuf.h"
+
 #define MAX_DEGREE	27 // 'a' ~ 'z' and EOW
 #define EOW			'$' // end of word
 
 // used in the following functions: trieInsert, trieSearch, triePrefixList
 #define getIndex(x)		(((x) == EOW) ? MAX_DEGREE-1 : ((x) - 'a'))
 
+// statistics (gcc -DSTATS), see trieStats
+#ifdef STATS
+static struct {
+	long node;			// nodes created
+	long malloc_bytes;	// nodes allocated
+	long visit;			// nodes passed by insert, search and prefix list
+} stats;
+#define STAT(x)		(x)
+#else
+#define STAT(x)		((void)0)
+#endif
+
 // TRIE type definition
 typedef struct trieNode {
 	int 			index; // -1 (non-word), 0, 1, 2, ...
@@ -27,6 +41,7 @@ void triePrefixList(TRIE *root, char *str, char *dic[]);
 int make_permuterms(char *str, char *permuterms[]);
 void clear_permuterms(char *permuterms[], int size);
 void trieSearchWildcard(TRIE *root, char *str, char *dic[]);
+void trieStats(FILE *fp);
 
 /* Allocates dynamic memory for a trie node and returns its address to caller
 	return	node pointer
@@ -35,6 +50,8 @@ void trieSearchWildcard(TRIE *root, char *str, char *dic[]);
 TRIE *trieCreateNode(void) {
     TRIE *newNode = (TRIE *)malloc(sizeof(TRIE));
     if (!newNode) return NULL;
+    STAT(stats.node++);
+    STAT(stats.malloc_bytes += sizeof(TRIE));
 
     newNode->index = -1;
     for (int i = 0; i < MAX_DEGREE; i++) {
@@ -91,6 +108,7 @@ int trieInsert(TRIE *root, char *str, int dic_index) {
             current->subtrees[index] = newNode;
         }
         current = current->subtrees[index];
+        STAT(stats.visit++);
         ptr++;
     }
 
@@ -121,6 +139,7 @@ int trieSearch(TRIE *root, char *str) {
 
         if (current->subtrees[index] == NULL) return -1;
         current = current->subtrees[index];
+        STAT(stats.visit++);
         ptr++;
     }
 
@@ -137,13 +156,18 @@ int trieSearch(TRIE *root, char *str) {
 
 
 /* prints all entries in trie using preorder traversal
+	buffered (outbuf), trieList flushes
 */
 
 static int trieList_main(TRIE *root, char *dic[], int count) {
     if (!root) return count;
 
     if (root->index != -1) {
-        printf("[%i]%s\n", count +1, dic[root->index]);
+        out_char('[');
+        out_int(count + 1);
+        out_char(']');
+        out_str(dic[root->index]);
+        out_char('\n');
         count++;
     }
 
@@ -168,6 +192,7 @@ void triePrefixList( TRIE *root, char *str, char *dic[]){
         int index = getIndex(*ptr);
         if (current->subtrees[index] == NULL) return;
         current = current->subtrees[index];
+        STAT(stats.visit++);
         ptr++;
     }
 
@@ -341,6 +366,7 @@ int main(int argc, char **argv)
         free(dic[i]);
     }
 
+    trieStats(stderr); // -DSTATS
     trieDestroy(permute_trie);
 
     return 0;
@@ -353,5 +379,20 @@ void trieList( TRIE *root, char *dic[])
 	if (root == NULL) return;
 
 	trieList_main(root, dic, 0);
+	out_flush();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/* prints the counters of trie operations as one line of JSON
+	(nodes created, bytes allocated for nodes, nodes passed by insert, search and prefix list)
+	the counters are compiled in with -DSTATS; otherwise nothing is printed
+*/
+void trieStats( FILE *fp)
+{
+#ifdef STATS
+	fprintf( fp, "{\"adt\": \"trie\", \"node\": %ld, \"malloc_bytes\": %ld, \"visit\": %ld}\n",
+		stats.node, stats.malloc_bytes, stats.visit);
+#else
+	(void)fp;
+#endif
+}
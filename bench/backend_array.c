@@ -0,0 +1,116 @@
+#include <stdlib.h> // malloc, realloc, free
+#include <string.h> // strdup, strcmp, memmove
+
+#include "bench.h"
+
+// sorted array with binary search (assignment02 word_count2)
+// tWord stored in the array, capacity grows by 1000
+
+// 사전(dictionary) 구조체
+typedef struct {
+	int		len;		// 배열에 저장된 단어의 수
+	int		capacity;	// 배열의 용량 (배열에 저장 가능한 단어의 수)
+	tWord	*data;		// 단어 구조체 배열에 대한 포인터
+} tWordDic;
+
+// found : key가 발견되는 경우 1, key가 발견되지 않는 경우 0
+// return	key가 발견되는 경우, 배열의 인덱스
+//			key가 발견되지 않는 경우, key가 삽입되어야 할 배열의 인덱스
+static int binary_search( tWordDic *dic, char *word, int *found)
+{
+	int l = 0, r = dic->len - 1;
+
+	*found = 0;
+	while (l <= r)
+	{
+		int m = (l + r) / 2;
+		int cmp = strcmp( word, dic->data[m].word);
+
+		if (cmp < 0) r = m - 1;
+		else if (cmp > 0) l = m + 1;
+		else
+		{
+			*found = 1;
+			return m;
+		}
+	}
+	return l;
+}
+
+static void *array_create( void)
+{
+	tWordDic *dic = (tWordDic *)malloc( sizeof(tWordDic));
+
+	if (!dic) return NULL;
+	dic->len = 0;
+	dic->capacity = 1000;
+	dic->data = (tWord *)malloc( dic->capacity * sizeof(tWord));
+	if (!dic->data)
+	{
+		free( dic);
+		return NULL;
+	}
+	return dic;
+}
+
+static void array_destroy( void *p)
+{
+	tWordDic *dic = (tWordDic *)p;
+
+	for (int i = 0; i < dic->len; i++) free( dic->data[i].word);
+	free( dic->data);
+	free( dic);
+}
+
+static int array_insert( void *p, char *word)
+{
+	tWordDic *dic = (tWordDic *)p;
+	int found, index = binary_search( dic, word, &found);
+
+	if (found)
+	{
+		dic->data[index].freq++;
+		return 2;
+	}
+	if (dic->len == dic->capacity)
+	{
+		tWord *data = (tWord *)realloc( dic->data, (dic->capacity + 1000) * sizeof(tWord));
+		if (!data) return 0;
+		dic->data = data;
+		dic->capacity += 1000;
+	}
+	memmove( &dic->data[index + 1], &dic->data[index], (dic->len - index) * sizeof(tWord));
+	dic->data[index].word = strdup( word);
+	dic->data[index].freq = 1;
+	dic->len++;
+	return 1;
+}
+
+static int array_search( void *p, char *word)
+{
+	tWordDic *dic = (tWordDic *)p;
+	int found, index = binary_search( dic, word, &found);
+
+	return found ? dic->data[index].freq : 0;
+}
+
+static int array_delete( void *p, char *word)
+{
+	tWordDic *dic = (tWordDic *)p;
+	int found, index = binary_search( dic, word, &found);
+
+	if (!found) return 0;
+	free( dic->data[index].word);
+	memmove( &dic->data[index], &dic->data[index + 1], (dic->len - index - 1) * sizeof(tWord));
+	dic->len--;
+	return 1;
+}
+
+static void array_traverse( void *p, void (*callback)(const void *))
+{
+	tWordDic *dic = (tWordDic *)p;
+
+	for (int i = 0; i < dic->len; i++) callback( &dic->data[i]);
+}
+
+BACKEND backend = { array_create, array_destroy, array_insert, array_search, array_delete, array_traverse};
@@ -0,0 +1,51 @@
+#include "bench.h"
+#include "avlt.h"
+
+// avlt.h of assignment08
+// linked with avlt.o (bench_avlt) or splay.o (bench_splay)
+
+static void *avlt_create( void)
+{
+	return AVLT_Create( compare_by_word);
+}
+
+static void avlt_destroy( void *dic)
+{
+	AVLT_Destroy( (TREE *)dic, destroyWord);
+}
+
+static int avlt_insert( void *dic, char *word)
+{
+	tWord *pWord = createWord( word);
+	int ret;
+
+	if (!pWord) return 0;
+	ret = AVLT_Insert( (TREE *)dic, pWord, increase_freq);
+	if (ret != 1) destroyWord( pWord);
+	return ret;
+}
+
+static int avlt_search( void *dic, char *word)
+{
+	tWord key = { word, 0};
+	tWord *pWord = (tWord *)AVLT_Search( (TREE *)dic, &key);
+
+	return pWord ? pWord->freq : 0;
+}
+
+static int avlt_delete( void *dic, char *word)
+{
+	tWord key = { word, 0};
+	tWord *pWord = (tWord *)AVLT_Delete( (TREE *)dic, &key);
+
+	if (!pWord) return 0;
+	destroyWord( pWord);
+	return 1;
+}
+
+static void avlt_traverse( void *dic, void (*callback)(const void *))
+{
+	AVLT_Traverse( (TREE *)dic, callback);
+}
+
+BACKEND backend = { avlt_create, avlt_destroy, avlt_insert, avlt_search, avlt_delete, avlt_traverse};
@@ -0,0 +1,50 @@
+#include "bench.h"
+#include "bst.h"
+
+// bst.h of assignment06 (bench_bst)
+
+static void *bst_create( void)
+{
+	return BST_Create( compare_by_word);
+}
+
+static void bst_destroy( void *dic)
+{
+	BST_Destroy( (TREE *)dic, destroyWord);
+}
+
+static int bst_insert( void *dic, char *word)
+{
+	tWord *pWord = createWord( word);
+	int ret;
+
+	if (!pWord) return 0;
+	ret = BST_Insert( (TREE *)dic, pWord, increase_freq);
+	if (ret != 1) destroyWord( pWord);
+	return ret;
+}
+
+static int bst_search( void *dic, char *word)
+{
+	tWord key = { word, 0};
+	tWord *pWord = (tWord *)BST_Search( (TREE *)dic, &key);
+
+	return pWord ? pWord->freq : 0;
+}
+
+static int bst_delete( void *dic, char *word)
+{
+	tWord key = { word, 0};
+	tWord *pWord = (tWord *)BST_Delete( (TREE *)dic, &key);
+
+	if (!pWord) return 0;
+	destroyWord( pWord);
+	return 1;
+}
+
+static void bst_traverse( void *dic, void (*callback)(const void *))
+{
+	BST_Traverse( (TREE *)dic, callback);
+}
+
+BACKEND backend = { bst_create, bst_destroy, bst_insert, bst_search, bst_delete, bst_traverse};
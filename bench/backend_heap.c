@@ -0,0 +1,41 @@
+#include "bench.h"
+#include "adt_heap.h"
+
+// adt_heap.h of assignment07 (bench_heap)
+// no counting : insert pushes every token, delete pops the largest word (the key is not used)
+// search and traverse are not supported
+
+static void *heap_create( void)
+{
+	return heap_Create( compare_by_word);
+}
+
+static void heap_destroy( void *dic)
+{
+	heap_Destroy( (HEAP *)dic, destroyWord);
+}
+
+static int heap_insert( void *dic, char *word)
+{
+	tWord *pWord = createWord( word);
+
+	if (!pWord) return 0;
+	if (!heap_Insert( (HEAP *)dic, pWord))
+	{
+		destroyWord( pWord);
+		return 0;
+	}
+	return 1;
+}
+
+static int heap_delete( void *dic, char *word)
+{
+	void *dataPtr;
+
+	(void)word;
+	if (!heap_Delete( (HEAP *)dic, &dataPtr)) return 0;
+	destroyWord( dataPtr);
+	return 1;
+}
+
+BACKEND backend = { heap_create, heap_destroy, heap_insert, NULL, heap_delete, NULL};
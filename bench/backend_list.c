@@ -0,0 +1,58 @@
+#include <stdlib.h> // free
+
+#include "bench.h"
+#include "adt_dlist.h"
+
+// adt_dlist.h of assignment05
+// linked with adt_dlist.o (bench_dlist) or adt_skiplist.o (bench_skiplist)
+
+static void increase_freq_list( const void *dataPtr)
+{
+	increase_freq( (void *)dataPtr);
+}
+
+static void *list_create( void)
+{
+	return createList( compare_by_word);
+}
+
+static void list_destroy( void *dic)
+{
+	destroyList( (LIST *)dic, destroyWord);
+}
+
+static int list_insert( void *dic, char *word)
+{
+	tWord *pWord = createWord( word);
+	int ret;
+
+	if (!pWord) return 0;
+	ret = addNode( (LIST *)dic, pWord, increase_freq_list);
+	if (ret != 1) destroyWord( pWord);
+	return ret;
+}
+
+static int list_search( void *dic, char *word)
+{
+	tWord key = { word, 0};
+	void *dataPtr;
+
+	return searchNode( (LIST *)dic, &key, &dataPtr) ? ((tWord *)dataPtr)->freq : 0;
+}
+
+static int list_delete( void *dic, char *word)
+{
+	tWord key = { word, 0};
+	void *dataPtr;
+
+	if (!removeNode( (LIST *)dic, &key, &dataPtr)) return 0;
+	destroyWord( dataPtr);
+	return 1;
+}
+
+static void list_traverse( void *dic, void (*callback)(const void *))
+{
+	traverseList( (LIST *)dic, callback);
+}
+
+BACKEND backend = { list_create, list_destroy, list_insert, list_search, list_delete, list_traverse};
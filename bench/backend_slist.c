@@ -0,0 +1,114 @@
+#include <stdlib.h> // malloc, free
+#include <string.h> // strcmp
+
+#include "bench.h"
+
+// sorted singly linked list (assignment03 word_count3, word order only)
+// every operation walks from the head
+
+typedef struct node
+{
+	tWord		*dataPtr;
+	struct node	*link;
+} NODE;
+
+typedef struct
+{
+	int		count;
+	NODE	*head;
+} LIST;
+
+// return	1 found (pLoc), 0 not found (pLoc : next node or NULL)
+// pPre : node before pLoc, NULL if pLoc is the first node
+static int _search( LIST *pList, NODE **pPre, NODE **pLoc, char *word)
+{
+	int cmp = 1;
+
+	*pPre = NULL;
+	*pLoc = pList->head;
+	while (*pLoc && (cmp = strcmp( word, (*pLoc)->dataPtr->word)) > 0)
+	{
+		*pPre = *pLoc;
+		*pLoc = (*pLoc)->link;
+	}
+	return *pLoc && cmp == 0;
+}
+
+static void *slist_create( void)
+{
+	LIST *list = (LIST *)malloc( sizeof(LIST));
+
+	if (list)
+	{
+		list->count = 0;
+		list->head = NULL;
+	}
+	return list;
+}
+
+static void slist_destroy( void *p)
+{
+	LIST *pList = (LIST *)p;
+
+	while (pList->head)
+	{
+		NODE *pLoc = pList->head;
+		pList->head = pLoc->link;
+		destroyWord( pLoc->dataPtr);
+		free( pLoc);
+	}
+	free( pList);
+}
+
+static int slist_insert( void *p, char *word)
+{
+	LIST *pList = (LIST *)p;
+	NODE *pPre, *pLoc, *newNode;
+
+	if (_search( pList, &pPre, &pLoc, word))
+	{
+		pLoc->dataPtr->freq++;
+		return 2;
+	}
+	newNode = (NODE *)malloc( sizeof(NODE));
+	if (!newNode) return 0;
+	newNode->dataPtr = createWord( word);
+	if (!newNode->dataPtr)
+	{
+		free( newNode);
+		return 0;
+	}
+	newNode->link = pLoc;
+	if (pPre) pPre->link = newNode;
+	else pList->head = newNode;
+	pList->count++;
+	return 1;
+}
+
+static int slist_search( void *p, char *word)
+{
+	NODE *pPre, *pLoc;
+
+	return _search( (LIST *)p, &pPre, &pLoc, word) ? pLoc->dataPtr->freq : 0;
+}
+
+static int slist_delete( void *p, char *word)
+{
+	LIST *pList = (LIST *)p;
+	NODE *pPre, *pLoc;
+
+	if (!_search( pList, &pPre, &pLoc, word)) return 0;
+	if (pPre) pPre->link = pLoc->link;
+	else pList->head = pLoc->link;
+	destroyWord( pLoc->dataPtr);
+	free( pLoc);
+	pList->count--;
+	return 1;
+}
+
+static void slist_traverse( void *p, void (*callback)(const void *))
+{
+	for (NODE *pLoc = ((LIST *)p)->head; pLoc; pLoc = pLoc->link) callback( pLoc->dataPtr);
+}
+
+BACKEND backend = { slist_create, slist_destroy, slist_insert, slist_search, slist_delete, slist_traverse};
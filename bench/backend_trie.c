@@ -0,0 +1,129 @@
+#include <stdlib.h> // malloc, free
+
+#include "bench.h"
+
+// trie (assignment09 permuterm_trie : 'a' ~ 'z' per level, no EOW)
+// a node holds the word ending there; preorder traversal is word order
+// words with other letters are not inserted (overflow)
+
+#define MAX_DEGREE	26 // 'a' ~ 'z'
+
+typedef struct trieNode {
+	tWord			*dataPtr; // NULL (non-word)
+	struct trieNode	*subtrees[MAX_DEGREE];
+} TRIE;
+
+static TRIE *trieCreateNode( void)
+{
+	TRIE *newNode = (TRIE *)malloc( sizeof(TRIE));
+
+	if (!newNode) return NULL;
+	newNode->dataPtr = NULL;
+	for (int i = 0; i < MAX_DEGREE; i++) newNode->subtrees[i] = NULL;
+	return newNode;
+}
+
+static void trieDestroy( TRIE *root)
+{
+	if (!root) return;
+	for (int i = 0; i < MAX_DEGREE; i++) trieDestroy( root->subtrees[i]);
+	if (root->dataPtr) destroyWord( root->dataPtr);
+	free( root);
+}
+
+static void *trie_create( void)
+{
+	return trieCreateNode();
+}
+
+static void trie_destroy( void *dic)
+{
+	trieDestroy( (TRIE *)dic);
+}
+
+static int trie_insert( void *dic, char *word)
+{
+	TRIE *current = (TRIE *)dic;
+
+	for (char *ptr = word; *ptr; ptr++)
+	{
+		int index = *ptr - 'a';
+
+		if (index < 0 || index >= MAX_DEGREE) return 0;
+		if (!current->subtrees[index] && !(current->subtrees[index] = trieCreateNode())) return 0;
+		current = current->subtrees[index];
+	}
+	if (current->dataPtr)
+	{
+		current->dataPtr->freq++;
+		return 2;
+	}
+	current->dataPtr = createWord( word);
+	return current->dataPtr ? 1 : 0;
+}
+
+static int trie_search( void *dic, char *word)
+{
+	TRIE *current = (TRIE *)dic;
+
+	for (char *ptr = word; *ptr && current; ptr++)
+	{
+		int index = *ptr - 'a';
+
+		if (index < 0 || index >= MAX_DEGREE) return 0;
+		current = current->subtrees[index];
+	}
+	return (current && current->dataPtr) ? current->dataPtr->freq : 0;
+}
+
+// deletes word under root, empty nodes on the way are freed
+// return	1 deleted, 0 not found
+static int _delete( TRIE *root, char *word)
+{
+	TRIE *child;
+	int index, ret;
+
+	if (*word == '\0')
+	{
+		if (!root->dataPtr) return 0;
+		destroyWord( root->dataPtr);
+		root->dataPtr = NULL;
+		return 1;
+	}
+
+	index = *word - 'a';
+	if (index < 0 || index >= MAX_DEGREE || !(child = root->subtrees[index])) return 0;
+
+	ret = _delete( child, word + 1);
+	if (ret && !child->dataPtr)
+	{
+		int i;
+		for (i = 0; i < MAX_DEGREE && !child->subtrees[i]; i++)
+			;
+		if (i == MAX_DEGREE)
+		{
+			free( child);
+			root->subtrees[index] = NULL;
+		}
+	}
+	return ret;
+}
+
+static int trie_delete( void *dic, char *word)
+{
+	return _delete( (TRIE *)dic, word);
+}
+
+static void _traverse( TRIE *root, void (*callback)(const void *))
+{
+	if (!root) return;
+	if (root->dataPtr) callback( root->dataPtr);
+	for (int i = 0; i < MAX_DEGREE; i++) _traverse( root->subtrees[i], callback);
+}
+
+static void trie_traverse( void *dic, void (*callback)(const void *))
+{
+	_traverse( (TRIE *)dic, callback);
+}
+
+BACKEND backend = { trie_create, trie_destroy, trie_insert, trie_search, trie_delete, trie_traverse};
@@ -0,0 +1,345 @@
+#include <stdio.h>
+#include <stdlib.h> // malloc, free, qsort, strtol, strtod, exit
+#include <string.h> // strdup, strcmp, strrchr, strncmp, memset
+#include <math.h> // pow
+#include <time.h> // clock_gettime
+#include <unistd.h> // fork
+#include <sys/wait.h> // waitpid
+#include <sys/resource.h> // getrusage
+
+#ifdef __linux__
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+#include "bench.h"
+
+// dictionary benchmark : the same workloads on every backend, results in CSV
+// INPUT : a file of words, or zipf:N:V:S (N tokens drawn from V words, frequency of rank k ~ 1/k^S)
+// workloads (each INPUT in its own process, so peak RSS is per INPUT)
+//	insert		every token is counted (a backend without counting, the heap, just pushes it)
+//	search		every token is searched again
+//	traverse	TRAVERSE_REPEAT ordered traversals, latency per visited word
+//	delete		every word returned as new by insert is deleted
+// columns : backend,input,workload,ops,sec,mops,p50_ns,p99_ns,peak_rss_kb,cache_misses
+// cache_misses is empty where perf_event_open is not available
+// usage: bench_BACKEND [-h] INPUT...		-h : header line first
+
+#define TRAVERSE_REPEAT	5
+
+static const char *backend_name;
+
+////////////////////////////////////////////////////////////////////////////////
+// timing
+
+static long long now_ns( void)
+{
+	struct timespec now;
+	clock_gettime( CLOCK_MONOTONIC, &now);
+	return now.tv_sec * 1000000000LL + now.tv_nsec;
+}
+
+static int compare_long( const void *n1, const void *n2)
+{
+	long a = *(const long *)n1, b = *(const long *)n2;
+	return (a > b) - (a < b);
+}
+
+// cache misses of this process (user space), -1 if not available
+static int cache_fd = -1;
+
+static void cache_open( void)
+{
+#ifdef __linux__
+	struct perf_event_attr attr;
+
+	memset( &attr, 0, sizeof(attr));
+	attr.size = sizeof(attr);
+	attr.type = PERF_TYPE_HARDWARE;
+	attr.config = PERF_COUNT_HW_CACHE_MISSES;
+	attr.disabled = 1;
+	attr.exclude_kernel = 1;
+	attr.exclude_hv = 1;
+	cache_fd = (int)syscall( SYS_perf_event_open, &attr, 0, -1, -1, 0);
+#endif
+}
+
+static void cache_start( void)
+{
+#ifdef __linux__
+	if (cache_fd < 0) return;
+	ioctl( cache_fd, PERF_EVENT_IOC_RESET, 0);
+	ioctl( cache_fd, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+}
+
+static long long cache_stop( void)
+{
+	long long count = -1;
+#ifdef __linux__
+	if (cache_fd < 0) return -1;
+	ioctl( cache_fd, PERF_EVENT_IOC_DISABLE, 0);
+	if (read( cache_fd, &count, sizeof(count)) != sizeof(count)) count = -1;
+#endif
+	return count;
+}
+
+// one CSV row; lat (num_lat latencies in ns) is sorted
+static void report( const char *input, const char *workload, long ops, long long ns,
+	long *lat, int num_lat, long long misses)
+{
+	struct rusage usage;
+	double sec = ns / 1e9;
+
+	qsort( lat, num_lat, sizeof(long), compare_long);
+	getrusage( RUSAGE_SELF, &usage);
+
+	printf( "%s,%s,%s,%ld,%.6f,%.3f,%ld,%ld,%ld,", backend_name, input, workload, ops, sec,
+		sec > 0 ? ops / sec / 1e6 : 0.0,
+		num_lat ? lat[(num_lat - 1) * 50 / 100] : 0, num_lat ? lat[(num_lat - 1) * 99 / 100] : 0,
+		usage.ru_maxrss);
+	if (misses >= 0) printf( "%lld", misses);
+	printf( "\n");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// inputs
+
+static unsigned long long rand_state = 88172645463325252ULL;
+
+// xorshift64 : the same tokens on every run
+static unsigned long long rand64( void)
+{
+	rand_state ^= rand_state << 13;
+	rand_state ^= rand_state >> 7;
+	rand_state ^= rand_state << 17;
+	return rand_state;
+}
+
+// zipf:N:V:S
+// word of rank k : 3 random letters + k in base 26 (all different)
+// return	number of tokens, -1 if spec is wrong
+static int make_zipf( const char *spec, char ***tokens)
+{
+	char *end, word[32];
+	long n, v;
+	double s, sum = 0, *cdf;
+	char **vocabulary;
+
+	n = strtol( spec + 5, &end, 10);
+	if (*end != ':') return -1;
+	v = strtol( end + 1, &end, 10);
+	if (*end != ':') return -1;
+	s = strtod( end + 1, &end);
+	if (*end || n < 1 || v < 1) return -1;
+
+	cdf = (double *)malloc( v * sizeof(double));
+	vocabulary = (char **)malloc( v * sizeof(char *));
+	for (long k = 0; k < v; k++)
+	{
+		int len = 3;
+		for (int i = 0; i < 3; i++) word[i] = 'a' + rand64() % 26;
+		for (long x = k; ; x /= 26)
+		{
+			word[len++] = 'a' + x % 26;
+			if (x < 26) break;
+		}
+		word[len] = '\0';
+		vocabulary[k] = strdup( word);
+
+		sum += 1.0 / pow( k + 1, s);
+		cdf[k] = sum;
+	}
+
+	*tokens = (char **)malloc( n * sizeof(char *));
+	for (long i = 0; i < n; i++)
+	{
+		double u = (rand64() >> 11) * (1.0 / 9007199254740992.0) * sum;
+		long lo = 0, hi = v - 1;
+
+		while (lo < hi) // first rank with cdf > u
+		{
+			long mid = (lo + hi) / 2;
+			if (cdf[mid] > u) hi = mid;
+			else lo = mid + 1;
+		}
+		(*tokens)[i] = strdup( vocabulary[lo]);
+	}
+
+	for (long k = 0; k < v; k++) free( vocabulary[k]);
+	free( vocabulary);
+	free( cdf);
+	return (int)n;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// traversal check (check_word) and the number of visited words
+static long num_visited;
+
+static void visit_word( const void *dataPtr)
+{
+	num_visited++;
+	check_word( dataPtr);
+}
+
+// the four workloads on tokens
+// return	number of errors
+static int run( const char *input, char **tokens, int num_tokens)
+{
+	char **words = (char **)malloc( num_tokens * sizeof(char *)); // new words of insert
+	long *lat = (long *)malloc( (num_tokens + TRAVERSE_REPEAT) * sizeof(long));
+	int num_words = 0, errors = 0;
+	long long start, t, total, misses;
+	void *dic;
+
+	if (!words || !lat || !(dic = backend.create()))
+	{
+		fprintf( stderr, "Error: %s : overflow\n", backend_name);
+		return 1;
+	}
+
+	// insert
+	total = 0;
+	cache_start();
+	for (int i = 0; i < num_tokens; i++)
+	{
+		int ret;
+
+		start = now_ns();
+		ret = backend.insert( dic, tokens[i]);
+		t = now_ns() - start;
+		lat[i] = t;
+		total += t;
+
+		if (ret == 1) words[num_words++] = tokens[i];
+		else if (ret == 0) errors++;
+	}
+	misses = cache_stop();
+	report( input, "insert", num_tokens, total, lat, num_tokens, misses);
+
+	// search
+	if (backend.search)
+	{
+		long found = 0;
+
+		total = 0;
+		cache_start();
+		for (int i = 0; i < num_tokens; i++)
+		{
+			start = now_ns();
+			found += (backend.search( dic, tokens[i]) > 0);
+			t = now_ns() - start;
+			lat[i] = t;
+			total += t;
+		}
+		misses = cache_stop();
+		report( input, "search", num_tokens, total, lat, num_tokens, misses);
+		if (found != num_tokens) errors++;
+	}
+
+	// ordered traverse
+	if (backend.traverse)
+	{
+		long visited = 0, checksum;
+
+		total = 0;
+		cache_start();
+		for (int r = 0; r < TRAVERSE_REPEAT; r++)
+		{
+			num_visited = 0;
+
+			start = now_ns();
+			backend.traverse( dic, visit_word);
+			t = now_ns() - start;
+			checksum = check_result();
+			lat[r] = num_visited ? t / num_visited : 0;
+			total += t;
+			visited += num_visited;
+
+			if (num_visited != num_words || checksum != num_tokens) errors++;
+		}
+		misses = cache_stop();
+		report( input, "traverse", visited, total, lat, TRAVERSE_REPEAT, misses);
+	}
+
+	// delete
+	if (backend.delete)
+	{
+		long deleted = 0;
+
+		total = 0;
+		cache_start();
+		for (int i = 0; i < num_words; i++)
+		{
+			start = now_ns();
+			deleted += backend.delete( dic, words[i]);
+			t = now_ns() - start;
+			lat[i] = t;
+			total += t;
+		}
+		misses = cache_stop();
+		report( input, "delete", num_words, total, lat, num_words, misses);
+		if (deleted != num_words) errors++;
+	}
+
+	backend.destroy( dic);
+	free( lat);
+	free( words);
+
+	if (errors) fprintf( stderr, "Error: %s %s : %d errors\n", backend_name, input, errors);
+	return errors;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int main( int argc, char **argv)
+{
+	int first = 1, errors = 0;
+
+	if (argc > 1 && strcmp( argv[1], "-h") == 0) first = 2;
+	if (argc <= first)
+	{
+		fprintf( stderr, "usage: %s [-h] INPUT...\n", argv[0]);
+		fprintf( stderr, "\tINPUT : FILE or zipf:N:V:S\n");
+		return 1;
+	}
+
+	// bench_avlt -> avlt
+	backend_name = strrchr( argv[0], '/') ? strrchr( argv[0], '/') + 1 : argv[0];
+	if (strncmp( backend_name, "bench_", 6) == 0) backend_name += 6;
+
+	if (first == 2)
+		printf( "backend,input,workload,ops,sec,mops,p50_ns,p99_ns,peak_rss_kb,cache_misses\n");
+	fflush( stdout);
+
+	for (int a = first; a < argc; a++)
+	{
+		pid_t pid = fork(); // peak RSS of this input only
+		int status;
+
+		if (pid == 0)
+		{
+			char **tokens;
+			int num_tokens, ret;
+
+			if (strncmp( argv[a], "zipf:", 5) == 0) num_tokens = make_zipf( argv[a], &tokens);
+			else num_tokens = read_file( argv[a], &tokens);
+			if (num_tokens < 0)
+			{
+				fprintf( stderr, "Error: cannot read input [%s]\n", argv[a]);
+				exit( 2);
+			}
+
+			cache_open();
+			ret = run( argv[a], tokens, num_tokens);
+
+			free_tokens( tokens, num_tokens);
+			fflush( stdout);
+			exit( ret ? 1 : 0);
+		}
+		if (pid < 0 || waitpid( pid, &status, 0) < 0 || !WIFEXITED( status) || WEXITSTATUS( status))
+			errors++;
+	}
+
+	return errors ? 1 : 0;
+}
@@ -0,0 +1,35 @@
+////////////////////////////////////////////////////////////////////////////////
+// dictionary backends for bench.c
+// one program per backend : bench.o + backend_*.o (+ the ADT of assignment05 .. 08)
+
+#include "bench_util.h" // tWord, createWord, destroyWord, compare_by_word, increase_freq
+
+// functions of one backend
+// a function is NULL if the backend does not support the workload (no row in the CSV)
+typedef struct {
+	// return	dictionary
+	//			NULL if overflow
+	void	*(*create)( void);
+
+	// frees the dictionary and its words
+	void	(*destroy)( void *dic);
+
+	// counts word (new word with freq 1, or freq++)
+	// return	1 new word
+	//			2 counted again
+	//			0 overflow
+	int		(*insert)( void *dic, char *word);
+
+	// return	frequency of word
+	//			0 not found
+	int		(*search)( void *dic, char *word);
+
+	// return	1 deleted
+	//			0 not found
+	int		(*delete)( void *dic, char *word);
+
+	// calls callback with every tWord in word order
+	void	(*traverse)( void *dic, void (*callback)(const void *));
+} BACKEND;
+
+extern BACKEND backend; // backend_*.c
@@ -0,0 +1,91 @@
+#include <stdio.h>
+#include <stdlib.h> // malloc, realloc, free
+#include <string.h> // strdup, strcmp
+
+#include "bench_util.h"
+
+////////////////////////////////////////////////////////////////////////////////
+tWord *createWord( char *word){
+	tWord *newWord = (tWord *)malloc(sizeof(tWord));
+	if (!newWord) return NULL;
+	newWord->word = strdup(word);
+	newWord->freq = 1;
+	return newWord;
+}
+
+void destroyWord( void *pNode){
+	tWord *wordNode = (tWord *)pNode;
+	free(wordNode->word);
+	free(wordNode);
+}
+
+int compare_by_word( const void *n1, const void *n2)
+{
+	return strcmp( ((tWord *)n1)->word, ((tWord *)n2)->word);
+}
+
+void increase_freq( void *dataPtr)
+{
+	((tWord *)dataPtr)->freq++;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+double elapsed( struct timespec *start)
+{
+	struct timespec now;
+	clock_gettime( CLOCK_MONOTONIC, &now);
+	return (now.tv_sec - start->tv_sec) + (now.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int read_file( const char *name, char ***tokens)
+{
+	char word[100];
+	int num_tokens = 0, capacity = 0;
+	FILE *fp = fopen( name, "rt");
+
+	if (!fp) return -1;
+
+	*tokens = NULL;
+	while (fscanf( fp, "%99s", word) != EOF)
+	{
+		if (num_tokens == capacity)
+		{
+			capacity = capacity ? capacity * 2 : 1024;
+			*tokens = (char **)realloc( *tokens, capacity * sizeof(char *));
+		}
+		(*tokens)[num_tokens++] = strdup( word);
+	}
+	fclose( fp);
+	return num_tokens;
+}
+
+void free_tokens( char **tokens, int num_tokens)
+{
+	for (int i = 0; i < num_tokens; i++) free( tokens[i]);
+	free( tokens);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+static long checksum;
+static int out_of_order;
+static const char *prev_word;
+
+void check_word( const void *dataPtr)
+{
+	const tWord *pWord = (const tWord *)dataPtr;
+
+	checksum += pWord->freq;
+	if (prev_word && strcmp( prev_word, pWord->word) >= 0) out_of_order = 1;
+	prev_word = pWord->word;
+}
+
+long check_result( void)
+{
+	long result = out_of_order ? -1 : checksum;
+
+	checksum = 0;
+	out_of_order = 0;
+	prev_word = NULL;
+	return result;
+}
@@ -0,0 +1,40 @@
+////////////////////////////////////////////////////////////////////////////////
+// shared parts of the benchmarks (assignment08 *_bench.c, bench/bench.c)
+// the word record with its callbacks, timing, the token file and the traversal check
+#include <time.h> // struct timespec
+
+// User structure type definition
+// 단어 구조체
+typedef struct {
+	char	*word;		// 단어
+	int		freq;		// 빈도
+} tWord;
+
+// new word with freq 1 (a copy of word)
+// return	NULL if overflow
+tWord *createWord( char *word);
+
+void destroyWord( void *pNode);
+
+int compare_by_word( const void *n1, const void *n2);
+
+// for the insert functions : freq++ of a word already in the container
+void increase_freq( void *dataPtr);
+
+// 경과 시간 (초) since start (CLOCK_MONOTONIC)
+double elapsed( struct timespec *start);
+
+// 입력 단어를 미리 메모리에 읽어 둠 (파일 읽기 시간 제외)
+// *tokens : strdup copies of the words of the file, in file order
+// return	number of tokens, -1 if the file cannot be opened
+int read_file( const char *name, char ***tokens);
+
+void free_tokens( char **tokens, int num_tokens);
+
+// traversal check : order of words and sum of frequencies
+// check_word is the traverse callback, check_result ends one traversal
+// return	sum of freq of the visited words
+//			-1 if a word was not greater than the one before
+void check_word( const void *dataPtr);
+
+long check_result( void);
@@ -0,0 +1,143 @@
+#include <stdlib.h> // malloc, calloc, realloc, free
+#include <string.h> // memcmp, memcpy
+
+#include "intern.h"
+
+char			*intern_pool;
+INTERN_ENTRY	*intern_entry;
+
+static size_t pool_length, pool_capacity;	// bytes of intern_pool
+static unsigned num, capacity;				// handles 1 .. num of intern_entry
+static STR *table;							// open addressing (linear probing), 0 : empty slot
+static unsigned size;						// slots (power of 2)
+
+// FNV-1a and the length in one pass
+static unsigned _hash( const char *s, unsigned *len)
+{
+	const unsigned char *p = (const unsigned char *)s;
+	unsigned h = 2166136261U;
+
+	while (*p)
+	{
+		h ^= *p++;
+		h *= 16777619U;
+	}
+	*len = (unsigned)(p - (const unsigned char *)s);
+	return h;
+}
+
+// slot of s (an empty slot if s is not in the pool)
+// equal hash and length are checked before the bytes
+static unsigned _slot( const char *s, unsigned len, unsigned hash)
+{
+	unsigned i = hash & (size - 1);
+
+	while (table[i])
+	{
+		INTERN_ENTRY *e = &intern_entry[table[i]];
+		if (e->hash == hash && e->len == len && memcmp( intern_pool + e->offset, s, len) == 0) break;
+		i = (i + 1) & (size - 1);
+	}
+	return i;
+}
+
+// twice the slots (1024 at first)
+// return	0 if overflow
+static int _grow_table( void)
+{
+	unsigned new_size = size ? size * 2 : 1024;
+	STR *new_table = (STR *)calloc( new_size, sizeof(STR));
+
+	if (!new_table) return 0;
+	for (unsigned i = 0; i < size; i++)
+	{
+		if (table[i])
+		{
+			unsigned j = intern_entry[table[i]].hash & (new_size - 1);
+			while (new_table[j]) j = (j + 1) & (new_size - 1);
+			new_table[j] = table[i];
+		}
+	}
+	free( table);
+	table = new_table;
+	size = new_size;
+	return 1;
+}
+
+STR intern( const char *s)
+{
+	unsigned len, hash = _hash( s, &len), i;
+	INTERN_ENTRY *e;
+
+	if (size)
+	{
+		i = _slot( s, len, hash);
+		if (table[i]) return table[i]; // 이미 있는 문자열 : no allocation
+	}
+
+	// a new string
+	if (4 * (num + 1) > 3 * size)
+	{
+		if (!_grow_table()) return 0;
+	}
+	if (num + 1 >= capacity)
+	{
+		unsigned new_capacity = capacity ? capacity * 2 : 1024;
+		INTERN_ENTRY *new_entry = (INTERN_ENTRY *)realloc( intern_entry, new_capacity * sizeof(INTERN_ENTRY));
+		if (!new_entry) return 0;
+		intern_entry = new_entry;
+		capacity = new_capacity;
+	}
+	if (pool_length + len + 1 > pool_capacity)
+	{
+		size_t new_capacity = pool_capacity ? pool_capacity * 2 : 1 << 16;
+		char *new_pool;
+
+		while (pool_length + len + 1 > new_capacity) new_capacity *= 2;
+		new_pool = (char *)realloc( intern_pool, new_capacity);
+		if (!new_pool) return 0;
+		intern_pool = new_pool;
+		pool_capacity = new_capacity;
+	}
+
+	e = &intern_entry[++num];
+	e->offset = (unsigned)pool_length;
+	e->len = len;
+	e->hash = hash;
+	memcpy( intern_pool + pool_length, s, len + 1);
+	pool_length += len + 1;
+
+	table[_slot( s, len, hash)] = num;
+	return num;
+}
+
+STR intern_find( const char *s)
+{
+	unsigned len, hash;
+
+	if (!size) return 0;
+	hash = _hash( s, &len);
+	return table[_slot( s, len, hash)];
+}
+
+int intern_count( void)
+{
+	return (int)num;
+}
+
+size_t intern_bytes( void)
+{
+	return pool_capacity + (size_t)capacity * sizeof(INTERN_ENTRY) + (size_t)size * sizeof(STR);
+}
+
+void intern_clear( void)
+{
+	free( intern_pool);
+	free( intern_entry);
+	free( table);
+	intern_pool = NULL;
+	intern_entry = NULL;
+	table = NULL;
+	pool_length = pool_capacity = 0;
+	num = capacity = size = 0;
+}
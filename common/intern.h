@@ -0,0 +1,39 @@
+////////////////////////////////////////////////////////////////////////////////
+// string intern pool
+// every distinct string is stored once, one after another in one pool, with its length and hash
+// a string is known by its handle (1, 2, ...) : equal strings have equal handles
+// handles stay valid as the pool grows; a pointer from intern_str may move at the next intern
+// strings are not removed one by one (intern_clear empties the pool)
+
+typedef unsigned STR;	// handle, 0 : none
+
+typedef struct {
+	unsigned	offset;	// of the string in intern_pool
+	unsigned	len;	// strlen
+	unsigned	hash;	// FNV-1a
+} INTERN_ENTRY;
+
+extern char			*intern_pool;
+extern INTERN_ENTRY	*intern_entry;	// indexed by handle
+
+// string, length and hash of handle h
+#define intern_str( h)	(intern_pool + intern_entry[h].offset)
+#define intern_len( h)	(intern_entry[h].len)
+#define intern_hash( h)	(intern_entry[h].hash)
+
+// handle of s, s is copied into the pool only if it is new
+// return	0 if overflow
+STR intern( const char *s);
+
+// handle of s, never allocates
+// return	0 if s is not in the pool
+STR intern_find( const char *s);
+
+// number of strings in the pool
+int intern_count( void);
+
+// bytes allocated for the pool, the entries and the hash table
+size_t intern_bytes( void);
+
+// frees the pool (every handle becomes invalid)
+void intern_clear( void);
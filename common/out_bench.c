@@ -0,0 +1,80 @@
+#include <stdio.h>
+#include <stdlib.h> // malloc, realloc, free, atoi
+#include <string.h> // strdup
+#include <time.h> // clock_gettime
+
+#include "outbuf.h"
+
+// dumping a dictionary : printf per entry vs outbuf (print_word "%s\t%d\n")
+// the words of FILE with frequencies, repeated until N entries
+// the output goes to stdout (redirect to /dev/null or a file), times to stderr
+// usage: out_bench FILE [N] > /dev/null
+
+// 경과 시간 (초)
+static double elapsed( struct timespec *start)
+{
+	struct timespec now;
+	clock_gettime( CLOCK_MONOTONIC, &now);
+	return (now.tv_sec - start->tv_sec) + (now.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int main( int argc, char **argv)
+{
+	char word[100];
+	char **tokens = NULL;
+	int num_tokens = 0, capacity = 0, n = 5000000;
+	double t_printf, t_out;
+	struct timespec start;
+	FILE *fp;
+
+	if (argc != 2 && argc != 3) {
+		fprintf( stderr, "usage: %s FILE [N] > /dev/null\n", argv[0]);
+		return 1;
+	}
+	if (argc == 3) n = atoi( argv[2]);
+
+	fp = fopen( argv[1], "rt");
+	if (!fp)
+	{
+		fprintf( stderr, "Error: cannot open file [%s]\n", argv[1]);
+		return 2;
+	}
+
+	// 입력 단어를 미리 메모리에 읽어 둠 (파일 읽기 시간 제외)
+	while (fscanf( fp, "%99s", word) != EOF)
+	{
+		if (num_tokens == capacity)
+		{
+			capacity = capacity ? capacity * 2 : 1024;
+			tokens = (char **)realloc( tokens, capacity * sizeof(char *));
+		}
+		tokens[num_tokens++] = strdup( word);
+	}
+	fclose( fp);
+	if (num_tokens == 0) return 0;
+
+	clock_gettime( CLOCK_MONOTONIC, &start);
+	for (int i = 0; i < n; i++)
+		printf( "%s\t%d\n", tokens[i % num_tokens], i);
+	fflush( stdout);
+	t_printf = elapsed( &start);
+
+	clock_gettime( CLOCK_MONOTONIC, &start);
+	for (int i = 0; i < n; i++)
+	{
+		out_str( tokens[i % num_tokens]);
+		out_char( '\t');
+		out_int( i);
+		out_char( '\n');
+	}
+	out_flush();
+	t_out = elapsed( &start);
+
+	fprintf( stderr, "%d entries\tprintf %.3f sec\toutbuf %.3f sec\t%.2fx\n",
+		n, t_printf, t_out, t_printf / t_out);
+
+	for (int i = 0; i < num_tokens; i++) free( tokens[i]);
+	free( tokens);
+	return 0;
+}
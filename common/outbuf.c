@@ -0,0 +1,67 @@
+#include <stdio.h>
+#include <string.h> // strlen, memcpy
+
+#include "outbuf.h"
+
+#ifdef __GLIBC__
+#define WRITE(ptr, size)	fwrite_unlocked( (ptr), 1, (size), stdout)
+#else
+#define WRITE(ptr, size)	fwrite( (ptr), 1, (size), stdout)
+#endif
+
+static char buffer[OUT_BUFSIZE];
+static int length;
+
+// writes the buffer out
+static void _drain( void)
+{
+	if (length) WRITE( buffer, length);
+	length = 0;
+}
+
+void out_str( const char *s)
+{
+	size_t n = strlen( s);
+
+	if (length + n > OUT_BUFSIZE)
+	{
+		_drain();
+		if (n > OUT_BUFSIZE)
+		{
+			WRITE( s, n);
+			return;
+		}
+	}
+	memcpy( buffer + length, s, n);
+	length += n;
+}
+
+void out_char( int c)
+{
+	if (length == OUT_BUFSIZE) _drain();
+	buffer[length++] = (char)c;
+}
+
+// digits are written backwards into a small array, then copied
+void out_int( long long n)
+{
+	char digits[24];
+	int i = sizeof(digits);
+	unsigned long long u = (n < 0) ? 0ULL - (unsigned long long)n : (unsigned long long)n;
+
+	do {
+		digits[--i] = '0' + u % 10;
+		u /= 10;
+	} while (u);
+	if (n < 0) digits[--i] = '-';
+
+	if (length + (int)sizeof(digits) > OUT_BUFSIZE) _drain();
+	memcpy( buffer + length, digits + i, sizeof(digits) - i);
+	length += sizeof(digits) - i;
+}
+
+void out_flush( void)
+{
+	_drain();
+	fflush( stdout);
+}
@@ -0,0 +1,19 @@
+////////////////////////////////////////////////////////////////////////////////
+// buffered bulk output to stdout
+// print callbacks of traversals append to one large buffer (no formatting, no locking per entry)
+// and the buffer goes to stdout with one fwrite_unlocked per OUT_BUFSIZE bytes
+// the same order as printf : call out_flush before printing with stdio again (and before exit)
+
+#define OUT_BUFSIZE	(1 << 16)
+
+// appends string s
+void out_str( const char *s);
+
+// appends character c
+void out_char( int c);
+
+// appends n in decimal (the same as printf "%lld")
+void out_int( long long n);
+
+// writes the buffer to stdout (and flushes stdout)
+void out_flush( void);
@@ -0,0 +1,913 @@
+#include <stdio.h>
+#include <stdlib.h> // malloc, calloc, realloc, qsort
+#include <limits.h> // INT_MAX, LONG_MAX
+#include <string.h> // memchr, memmove
+#include <strings.h> // strncasecmp
+#include <fcntl.h> // open
+#include <unistd.h> // close
+#include <sys/mman.h> // mmap, munmap, madvise
+#include <sys/stat.h> // fstat
+#include <pthread.h>
+
+#include "adt_graph.h"
+
+#define MAX_SECTION		64
+#define MAX_THREAD		64
+#define INSERTION_CUT	16 // rows shorter than this are sorted by insertion sort
+
+#define SNAPSHOT_MAGIC		"GRAPHBIN"
+#define SNAPSHOT_VERSION	1
+
+// header of a binary snapshot (graph_Save)
+// the offset array that follows it starts 8-byte aligned
+typedef struct
+{
+	char	magic[8];
+	int		version;
+	int		num_vertex;
+	long	num_edge;
+	int		directed;
+	int		weighted;
+} SNAPSHOT;
+
+// an edge list section of the .net file (lines after *Edges or *Arcs)
+typedef struct
+{
+	const char	*begin;
+	const char	*end;
+	int			directed;
+} SECTION;
+
+// a piece of a section parsed by one thread
+typedef struct
+{
+	const char	*begin;
+	const char	*end;
+	int			directed;
+	int			weighted;	// pass 1 : set if a third column (weight) was seen
+	int			error;		// set if a malformed line or an out of range vertex was seen
+	long		num_edge;	// edge scan : number of edges passed to the callback
+} CHUNK;
+
+// arguments of a loader thread
+typedef struct
+{
+	GRAPH	*graph;
+	CHUNK	*chunks;
+	int		num_chunk;
+	int		tid;
+	int		num_thread;
+	long	*count;		// pass 1 : degree of each vertex, pass 2 : fill cursor
+	int		shared;		// 1 if count is updated by several threads
+	void	(*callback)(int from, int to, int weight, void *arg); // edge scan
+	void	*arg;
+} WORKER;
+
+// (neighbor, weight) pair used when sorting a weighted row
+typedef struct
+{
+	int	to;
+	int	weight;
+} PAIR;
+
+////////////////////////////////////////////////////////////////////////////////
+// integer scanner
+
+// skips blanks in a line (not the newline)
+static inline const char *_skip_blank( const char *p, const char *end)
+{
+	while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) p++;
+	return p;
+}
+
+// parses a decimal integer starting at p
+// the number must end at a blank or the end of the line, and fit in an int
+// return	pointer just after the number
+//			NULL if there is no such number at p (e.g. 1.5, 12x, 3000000000)
+static inline const char *_parse_int( const char *p, const char *end, long *value)
+{
+	int neg = 0;
+	long v = 0;
+
+	if (p < end && (*p == '-' || *p == '+')) neg = (*p++ == '-');
+	if (p == end || (unsigned)(*p - '0') > 9) return NULL;
+
+	while (p < end && (unsigned)(*p - '0') <= 9)
+	{
+		v = v * 10 + (*p++ - '0');
+		if (v > INT_MAX + 1L) return NULL;
+	}
+	if (!neg && v > INT_MAX) return NULL;
+	if (p < end && *p != ' ' && *p != '\t' && *p != '\r' && *p != '\n') return NULL;
+
+	*value = neg ? -v : v;
+	return p;
+}
+
+// parses one edge line "from to [weight]"
+// return	number of columns parsed (0 for a blank line)
+//			1 if a column is not an integer
+static inline int _parse_line( const char *p, const char *eol, long *from, long *to, long *weight)
+{
+	p = _skip_blank( p, eol);
+	if (p == eol) return 0;
+
+	if ((p = _parse_int( p, eol, from)) == NULL) return 1;
+	p = _skip_blank( p, eol);
+	if ((p = _parse_int( p, eol, to)) == NULL) return 1;
+	p = _skip_blank( p, eol);
+	if (p == eol) return 2;
+	if ((p = _parse_int( p, eol, weight)) == NULL) return 1;
+	return 3;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// loader passes
+
+// returns count[v] and increments it
+// atomic only when several threads share count (a locked add is several times slower)
+static inline long _fetch_inc( WORKER *w, long v)
+{
+	if (w->shared) return __atomic_fetch_add( &w->count[v], 1, __ATOMIC_RELAXED);
+	return w->count[v]++;
+}
+
+// pass 1 : counts degree of each vertex
+static void _count_chunk( WORKER *w, CHUNK *c)
+{
+	long n = w->graph->num_vertex;
+	const char *p = c->begin;
+
+	while (p < c->end)
+	{
+		long from, to, weight;
+		const char *eol = memchr( p, '\n', c->end - p);
+		if (eol == NULL) eol = c->end;
+
+		int cols = _parse_line( p, eol, &from, &to, &weight);
+		if (cols == 1 || (cols >= 2 && (from < 1 || from > n || to < 1 || to > n)))
+		{
+			c->error = 1;
+			return;
+		}
+		if (cols >= 2)
+		{
+			_fetch_inc( w, from);
+			if (!c->directed && from != to)
+				_fetch_inc( w, to);
+			if (cols == 3) c->weighted = 1;
+		}
+		p = eol + 1;
+	}
+}
+
+// pass 2 : stores each edge at the cursor position of its end vertices
+static void _fill_chunk( WORKER *w, CHUNK *c)
+{
+	GRAPH *graph = w->graph;
+	const char *p = c->begin;
+
+	while (p < c->end)
+	{
+		long from, to, weight = 1;
+		const char *eol = memchr( p, '\n', c->end - p);
+		if (eol == NULL) eol = c->end;
+
+		if (_parse_line( p, eol, &from, &to, &weight) >= 2)
+		{
+			long pos = _fetch_inc( w, from);
+			graph->adj[pos] = (int)to;
+			if (graph->weight) graph->weight[pos] = (int)weight;
+
+			if (!c->directed && from != to)
+			{
+				pos = _fetch_inc( w, to);
+				graph->adj[pos] = (int)from;
+				if (graph->weight) graph->weight[pos] = (int)weight;
+			}
+		}
+		p = eol + 1;
+	}
+}
+
+// edge scan : passes each edge line to the callback without building adjacency
+static void _scan_chunk( WORKER *w, CHUNK *c)
+{
+	long n = w->graph->num_vertex;
+	const char *p = c->begin;
+
+	while (p < c->end)
+	{
+		long from, to, weight = 1;
+		const char *eol = memchr( p, '\n', c->end - p);
+		if (eol == NULL) eol = c->end;
+
+		int cols = _parse_line( p, eol, &from, &to, &weight);
+		if (cols == 1 || (cols >= 2 && (from < 1 || from > n || to < 1 || to > n)))
+		{
+			c->error = 1;
+			return;
+		}
+		if (cols >= 2)
+		{
+			w->callback( (int)from, (int)to, (int)weight, w->arg);
+			c->num_edge++;
+		}
+		p = eol + 1;
+	}
+}
+
+static int _compare_int( const void *a, const void *b)
+{
+	int x = *(const int *)a, y = *(const int *)b;
+	return (x > y) - (x < y);
+}
+
+static int _compare_pair( const void *a, const void *b)
+{
+	const PAIR *x = (const PAIR *)a, *y = (const PAIR *)b;
+	if (x->to != y->to) return (x->to > y->to) - (x->to < y->to);
+	return (x->weight > y->weight) - (x->weight < y->weight);
+}
+
+// sorts the neighbors of vertex v and removes duplicated edges
+// the smallest weight of duplicated edges is kept (it comes first after sorting)
+// return	number of unique neighbors (kept at the front of the row)
+static long _sort_row( GRAPH *graph, int v, PAIR **buf, long *buf_size)
+{
+	long begin = graph->offset[v];
+	long len = graph->offset[v + 1] - begin;
+	int *adj = graph->adj + begin;
+	int *weight = graph->weight ? graph->weight + begin : NULL;
+	long i, j, k;
+
+	if (len < 2) return len;
+
+	if (len < INSERTION_CUT)
+	{
+		for (i = 1; i < len; i++)
+		{
+			int to = adj[i], wt = weight ? weight[i] : 0;
+			for (j = i - 1; j >= 0 && (adj[j] > to || (adj[j] == to && weight && weight[j] > wt)); j--)
+			{
+				adj[j + 1] = adj[j];
+				if (weight) weight[j + 1] = weight[j];
+			}
+			adj[j + 1] = to;
+			if (weight) weight[j + 1] = wt;
+		}
+	}
+	else if (weight == NULL)
+	{
+		qsort( adj, len, sizeof(int), _compare_int);
+	}
+	else
+	{
+		if (*buf_size < len)
+		{
+			PAIR *temp = (PAIR *)realloc( *buf, len * sizeof(PAIR));
+			if (!temp) return -1;
+			*buf = temp;
+			*buf_size = len;
+		}
+		for (i = 0; i < len; i++)
+		{
+			(*buf)[i].to = adj[i];
+			(*buf)[i].weight = weight[i];
+		}
+		qsort( *buf, len, sizeof(PAIR), _compare_pair);
+		for (i = 0; i < len; i++)
+		{
+			adj[i] = (*buf)[i].to;
+			weight[i] = (*buf)[i].weight;
+		}
+	}
+
+	for (k = 1, i = 1; i < len; i++)
+	{
+		if (adj[i] == adj[k - 1]) continue;
+		adj[k] = adj[i];
+		if (weight) weight[k] = weight[i];
+		k++;
+	}
+	return k;
+}
+
+static void *_pass1_thread( void *arg)
+{
+	WORKER *w = (WORKER *)arg;
+	for (int i = w->tid; i < w->num_chunk; i += w->num_thread)
+		_count_chunk( w, &w->chunks[i]);
+	return NULL;
+}
+
+static void *_pass2_thread( void *arg)
+{
+	WORKER *w = (WORKER *)arg;
+	for (int i = w->tid; i < w->num_chunk; i += w->num_thread)
+		_fill_chunk( w, &w->chunks[i]);
+	return NULL;
+}
+
+static void *_scan_thread( void *arg)
+{
+	WORKER *w = (WORKER *)arg;
+	for (int i = w->tid; i < w->num_chunk; i += w->num_thread)
+		_scan_chunk( w, &w->chunks[i]);
+	return NULL;
+}
+
+// edge scan of a snapshot : vertices tid+1, tid+1+num_thread, ...
+// an undirected edge is reported once (from <= to)
+static void *_scan_snapshot_thread( void *arg)
+{
+	WORKER *w = (WORKER *)arg;
+	GRAPH *graph = w->graph;
+	long num_edge = 0;
+
+	for (int v = w->tid + 1; v <= graph->num_vertex; v += w->num_thread)
+	{
+		for (long e = graph->offset[v]; e < graph->offset[v + 1]; e++)
+		{
+			if (graph->adj[e] < 1 || graph->adj[e] > graph->num_vertex) // corrupt snapshot
+			{
+				w->chunks[w->tid].error = 1;
+				return NULL;
+			}
+			if (!graph->directed && graph->adj[e] < v) continue;
+			w->callback( v, graph->adj[e], graph->weight ? graph->weight[e] : 1, w->arg);
+			num_edge++;
+		}
+	}
+	w->chunks[w->tid].num_edge = num_edge;
+	return NULL;
+}
+
+// pass 3 : sorts rows of vertices tid+1, tid+1+num_thread, ...
+// count[v] receives the number of unique neighbors of v
+static void *_pass3_thread( void *arg)
+{
+	WORKER *w = (WORKER *)arg;
+	PAIR *buf = NULL;
+	long buf_size = 0;
+
+	for (int v = w->tid + 1; v <= w->graph->num_vertex; v += w->num_thread)
+		w->count[v] = _sort_row( w->graph, v, &buf, &buf_size);
+
+	free( buf);
+	return NULL;
+}
+
+// runs func on num_thread workers (in the calling thread if num_thread is 1)
+static void _run( WORKER *workers, int num_thread, void *(*func)(void *))
+{
+	pthread_t tid[MAX_THREAD];
+	int i, started = 0;
+
+	for (i = 1; i < num_thread; i++)
+	{
+		if (pthread_create( &tid[i], NULL, func, &workers[i]) != 0) break;
+		started = i;
+	}
+	func( &workers[0]);
+	// workers that could not be started are run here
+	for (i = started + 1; i < num_thread; i++) func( &workers[i]);
+	for (i = 1; i <= started; i++) pthread_join( tid[i], NULL);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// header parsing
+
+// returns the beginning of the next line (or end)
+static const char *_next_line( const char *p, const char *end)
+{
+	const char *eol = memchr( p, '\n', end - p);
+	return eol ? eol + 1 : end;
+}
+
+// checks whether the line at p starts with keyword (case insensitive) followed by a blank
+static int _is_keyword( const char *p, const char *end, const char *keyword)
+{
+	size_t len = strlen( keyword);
+	if ((size_t)(end - p) < len || strncasecmp( p, keyword, len) != 0) return 0;
+	return p + len == end || p[len] == ' ' || p[len] == '\t' || p[len] == '\r' || p[len] == '\n';
+}
+
+// returns the start of the next line beginning with '*', or end
+static const char *_next_section( const char *p, const char *end)
+{
+	while (p < end)
+	{
+		const char *q = _skip_blank( p, end);
+		if (q < end && *q == '*') return q;
+		p = _next_line( q, end);
+	}
+	return end;
+}
+
+// finds *Vertices and the edge list sections
+// return	number of sections
+//			-1 format error
+static int _parse_header( const char *map, const char *end, int *num_vertex, SECTION *sections)
+{
+	const char *p = _next_section( map, end);
+	long num;
+	int num_section = 0;
+
+	if (!_is_keyword( p, end, "*Vertices")) return -1;
+	p = _skip_blank( p + 9, end);
+	if ((p = _parse_int( p, end, &num)) == NULL || num <= 0 || num > 0x7ffffffe) return -1;
+	*num_vertex = (int)num;
+
+	// vertex label lines are skipped
+	p = _next_section( _next_line( p, end), end);
+
+	while (p < end)
+	{
+		int directed;
+
+		if (_is_keyword( p, end, "*Edges")) directed = 0;
+		else if (_is_keyword( p, end, "*Arcs")) directed = 1;
+		else return -1; // *Edgeslist, *Arcslist, *Matrix are not supported
+
+		if (num_section == MAX_SECTION) return -1;
+
+		sections[num_section].begin = _next_line( p, end);
+		sections[num_section].end = p = _next_section( sections[num_section].begin, end);
+		sections[num_section].directed = directed;
+		num_section++;
+	}
+	return num_section;
+}
+
+// splits each section into num_thread chunks at line boundaries
+// return	number of chunks
+static int _make_chunks( SECTION *sections, int num_section, int num_thread, CHUNK *chunks)
+{
+	int n = 0;
+
+	for (int s = 0; s < num_section; s++)
+	{
+		const char *begin = sections[s].begin;
+		const char *end = sections[s].end;
+		long size = end - begin;
+
+		for (int t = 0; t < num_thread; t++)
+		{
+			const char *stop = (t == num_thread - 1) ? end : begin + size * (t + 1) / num_thread;
+			const char *from = (t == 0) ? begin : chunks[n - 1].end;
+
+			// chunk boundaries are moved to the beginning of the next line
+			if (stop < end && stop > from) stop = _next_line( stop - 1, end);
+			if (stop < from) stop = from;
+
+			chunks[n].begin = from;
+			chunks[n].end = stop;
+			chunks[n].directed = sections[s].directed;
+			chunks[n].weighted = 0;
+			chunks[n].error = 0;
+			chunks[n].num_edge = 0;
+			n++;
+		}
+	}
+	return n;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// binary snapshot
+
+// size of a snapshot file for the given header (num_vertex > 0, num_edge >= 0)
+// return	-1 if the size does not fit in a long
+static long _snapshot_size( const SNAPSHOT *header)
+{
+	long size = sizeof(SNAPSHOT) + (header->num_vertex + 2L) * sizeof(long);
+	long per_edge = (header->weighted ? 2 : 1) * sizeof(int);
+
+	if (header->num_edge > (LONG_MAX - size) / per_edge) return -1;
+	return size + header->num_edge * per_edge;
+}
+
+// checks the header against the file size, no array is read
+static int _valid_header( const SNAPSHOT *header, long size)
+{
+	return header->version == SNAPSHOT_VERSION && header->num_vertex > 0 && header->num_edge >= 0
+		&& _snapshot_size( header) == size;
+}
+
+// sets up graph on a mapped snapshot
+// the arrays point directly into the mapping, nothing is copied
+// the offsets are checked (O(V)), the neighbour ids are not read (graph_Check)
+// return	graph pointer
+//			NULL if map is not a valid snapshot
+static GRAPH *_attach_snapshot( char *map, long size)
+{
+	const SNAPSHOT *header = (const SNAPSHOT *)map;
+	GRAPH *graph;
+
+	if (!_valid_header( header, size)) return NULL;
+
+	graph = (GRAPH *)calloc( 1, sizeof(GRAPH));
+	if (!graph) return NULL;
+
+	graph->num_vertex = header->num_vertex;
+	graph->num_edge = header->num_edge;
+	graph->directed = header->directed;
+	graph->offset = (long *)(map + sizeof(SNAPSHOT));
+	graph->adj = (int *)(graph->offset + header->num_vertex + 2);
+	graph->weight = header->weighted ? graph->adj + header->num_edge : NULL;
+	graph->map = map;
+	graph->map_size = size;
+
+	// offsets non-decreasing in [0, num_edge], ending at num_edge
+	// (a corrupt file would make graph_Degree and the traversals index out of bounds)
+	if (graph->offset[header->num_vertex + 1] != header->num_edge)
+	{
+		free( graph);
+		return NULL;
+	}
+	for (int v = 0; v <= header->num_vertex + 1; v++)
+	{
+		if (graph->offset[v] < (v ? graph->offset[v - 1] : 0) || graph->offset[v] > header->num_edge)
+		{
+			free( graph);
+			return NULL;
+		}
+	}
+	return graph;
+}
+
+int graph_Check( GRAPH *graph)
+{
+	for (long e = 0; e < graph->num_edge; e++)
+	{
+		if (graph->adj[e] < 1 || graph->adj[e] > graph->num_vertex) return 0;
+	}
+	return 1;
+}
+
+int graph_Save( GRAPH *graph, char *filename)
+{
+	SNAPSHOT header;
+	FILE *fp = fopen( filename, "wb");
+	int ok;
+
+	if (fp == NULL) return 0;
+
+	memset( &header, 0, sizeof(header));
+	memcpy( header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+	header.version = SNAPSHOT_VERSION;
+	header.num_vertex = graph->num_vertex;
+	header.num_edge = graph->num_edge;
+	header.directed = graph->directed;
+	header.weighted = (graph->weight != NULL);
+
+	ok = fwrite( &header, sizeof(header), 1, fp) == 1
+		&& fwrite( graph->offset, sizeof(long), graph->num_vertex + 2, fp) == (size_t)graph->num_vertex + 2
+		&& fwrite( graph->adj, sizeof(int), graph->num_edge, fp) == (size_t)graph->num_edge
+		&& (!graph->weight || fwrite( graph->weight, sizeof(int), graph->num_edge, fp) == (size_t)graph->num_edge);
+
+	if (fclose( fp) != 0) ok = 0;
+	return ok;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// maps the whole file read-only
+// return	mapped address (size in *size)
+//			NULL if the file cannot be opened or is empty
+static char *_map_file( char *filename, long *size)
+{
+	struct stat st;
+	char *map;
+	int fd = open( filename, O_RDONLY);
+
+	if (fd < 0 || fstat( fd, &st) < 0 || st.st_size == 0)
+	{
+		fprintf( stderr, "Error: cannot open file [%s]\n", filename);
+		if (fd >= 0) close( fd);
+		return NULL;
+	}
+
+	map = mmap( NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close( fd);
+	if (map == MAP_FAILED)
+	{
+		fprintf( stderr, "Error: cannot map file [%s]\n", filename);
+		return NULL;
+	}
+
+	*size = st.st_size;
+	return map;
+}
+
+// checks whether the mapped file is a snapshot written by graph_Save
+static int _is_snapshot( const char *map, long size)
+{
+	return size >= (long)sizeof(SNAPSHOT) && memcmp( map, SNAPSHOT_MAGIC, 8) == 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+GRAPH *graph_Load( char *filename, int num_thread)
+{
+	SECTION sections[MAX_SECTION];
+	CHUNK *chunks = NULL;
+	WORKER workers[MAX_THREAD];
+	GRAPH *graph = NULL;
+	long *count = NULL;
+	long size;
+	char *map;
+	int num_vertex, num_section, num_chunk;
+	int weighted = 0, directed = 0, error = 0;
+	long v, total;
+
+	if (num_thread < 1) num_thread = 1;
+	if (num_thread > MAX_THREAD) num_thread = MAX_THREAD;
+
+	if ((map = _map_file( filename, &size)) == NULL) return NULL;
+
+	if (_is_snapshot( map, size))
+	{
+		graph = _attach_snapshot( map, size);
+		if (graph) return graph;
+		goto format_error;
+	}
+
+	madvise( map, size, MADV_SEQUENTIAL);
+
+	num_section = _parse_header( map, map + size, &num_vertex, sections);
+	if (num_section < 0) goto format_error;
+
+	chunks = (CHUNK *)malloc( (num_section * num_thread + 1) * sizeof(CHUNK));
+	graph = (GRAPH *)calloc( 1, sizeof(GRAPH));
+	count = (long *)calloc( num_vertex + 2, sizeof(long));
+	if (!chunks || !graph || !count) goto overflow;
+
+	num_chunk = _make_chunks( sections, num_section, num_thread, chunks);
+	graph->num_vertex = num_vertex;
+
+	for (int t = 0; t < num_thread; t++)
+	{
+		workers[t].graph = graph;
+		workers[t].chunks = chunks;
+		workers[t].num_chunk = num_chunk;
+		workers[t].tid = t;
+		workers[t].num_thread = num_thread;
+		workers[t].count = count;
+		workers[t].shared = (num_thread > 1);
+	}
+
+	// pass 1 : degree count
+	_run( workers, num_thread, _pass1_thread);
+
+	for (int i = 0; i < num_chunk; i++)
+	{
+		weighted |= chunks[i].weighted;
+		directed |= chunks[i].directed;
+		error |= chunks[i].error;
+	}
+	if (error) goto format_error;
+
+	// offsets by prefix sum, count becomes the fill cursor
+	graph->offset = (long *)malloc( (num_vertex + 2) * sizeof(long));
+	if (!graph->offset) goto overflow;
+
+	graph->offset[0] = graph->offset[1] = 0;
+	for (v = 1; v <= num_vertex; v++)
+	{
+		graph->offset[v + 1] = graph->offset[v] + count[v];
+		count[v] = graph->offset[v];
+	}
+	total = graph->offset[num_vertex + 1];
+
+	graph->adj = (int *)malloc( (total ? total : 1) * sizeof(int));
+	if (!graph->adj) goto overflow;
+	if (weighted)
+	{
+		graph->weight = (int *)malloc( (total ? total : 1) * sizeof(int));
+		if (!graph->weight) goto overflow;
+	}
+
+	// pass 2 : fill
+	_run( workers, num_thread, _pass2_thread);
+
+	munmap( map, size);
+	map = NULL;
+
+	// pass 3 : sort each row and merge duplicated edges
+	_run( workers, num_thread, _pass3_thread);
+
+	for (v = 1, total = 0; v <= num_vertex; v++)
+	{
+		long begin = graph->offset[v];
+		long len = count[v];
+
+		if (len < 0) goto overflow;
+		if (begin != total)
+		{
+			memmove( graph->adj + total, graph->adj + begin, len * sizeof(int));
+			if (graph->weight) memmove( graph->weight + total, graph->weight + begin, len * sizeof(int));
+		}
+		graph->offset[v] = total;
+		total += len;
+	}
+	graph->offset[num_vertex + 1] = total;
+	graph->num_edge = total;
+	graph->directed = directed;
+
+	free( count);
+	free( chunks);
+	return graph;
+
+format_error:
+	fprintf( stderr, "Error: invalid .net or snapshot format [%s]\n", filename);
+	goto cleanup;
+overflow:
+	fprintf( stderr, "Error: cannot allocate memory for [%s]\n", filename);
+cleanup:
+	if (map) munmap( map, size);
+	free( count);
+	free( chunks);
+	graph_Destroy( graph);
+	return NULL;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int graph_Vertices( char *filename)
+{
+	SECTION sections[MAX_SECTION];
+	int num_vertex = -1;
+	long size;
+	char *map = _map_file( filename, &size);
+
+	if (map == NULL) return -1;
+
+	if (_is_snapshot( map, size))
+	{
+		if (_valid_header( (const SNAPSHOT *)map, size)) num_vertex = ((const SNAPSHOT *)map)->num_vertex;
+	}
+	else if (_parse_header( map, map + size, &num_vertex, sections) < 0) num_vertex = -1;
+
+	munmap( map, size);
+	if (num_vertex < 0) fprintf( stderr, "Error: invalid .net or snapshot format [%s]\n", filename);
+	return num_vertex;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long graph_ScanEdges( char *filename, int num_thread, void (*callback)(int from, int to, int weight, void *arg), void *arg)
+{
+	SECTION sections[MAX_SECTION];
+	WORKER workers[MAX_THREAD];
+	CHUNK *chunks;
+	GRAPH header = {0}; // only num_vertex is used by the .net scan
+	GRAPH *graph = &header;
+	long size, num_edge = 0;
+	int num_section, num_chunk, error = 0, scanned = 0;
+	char *map;
+
+	if (num_thread < 1) num_thread = 1;
+	if (num_thread > MAX_THREAD) num_thread = MAX_THREAD;
+
+	if ((map = _map_file( filename, &size)) == NULL) return -1;
+
+	if (_is_snapshot( map, size))
+	{
+		if ((graph = _attach_snapshot( map, size)) == NULL) error = 1;
+		num_section = 0;
+		num_chunk = num_thread;
+	}
+	else
+	{
+		madvise( map, size, MADV_SEQUENTIAL);
+		num_section = _parse_header( map, map + size, &header.num_vertex, sections);
+		if (num_section < 0) error = 1;
+		num_chunk = num_section * num_thread;
+	}
+
+	chunks = error ? NULL : (CHUNK *)calloc( num_chunk + 1, sizeof(CHUNK));
+	if (chunks)
+	{
+		if (num_section > 0) num_chunk = _make_chunks( sections, num_section, num_thread, chunks);
+
+		for (int t = 0; t < num_thread; t++)
+		{
+			workers[t].graph = graph;
+			workers[t].chunks = chunks;
+			workers[t].num_chunk = num_chunk;
+			workers[t].tid = t;
+			workers[t].num_thread = num_thread;
+			workers[t].callback = callback;
+			workers[t].arg = arg;
+		}
+		_run( workers, num_thread, graph->map ? _scan_snapshot_thread : _scan_thread);
+
+		for (int i = 0; i < num_chunk; i++)
+		{
+			error |= chunks[i].error;
+			num_edge += chunks[i].num_edge;
+		}
+		free( chunks);
+		scanned = 1;
+	}
+
+	if (!graph) munmap( map, size); // invalid snapshot
+	else if (graph != &header) graph_Destroy( graph); // unmaps the snapshot
+	else munmap( map, size);
+
+	if (error)
+	{
+		fprintf( stderr, "Error: invalid .net or snapshot format [%s]\n", filename);
+		return -1;
+	}
+	return scanned ? num_edge : -1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+GRAPH *graph_Relabel( GRAPH *graph, int *new_id)
+{
+	int num_vertex = graph->num_vertex;
+	GRAPH *relabeled = (GRAPH *)calloc( 1, sizeof(GRAPH));
+	long total = graph->num_edge;
+	PAIR *buf = NULL;
+	long buf_size = 0;
+	int v, ok = 1;
+
+	if (!relabeled) return NULL;
+
+	relabeled->num_vertex = num_vertex;
+	relabeled->num_edge = total;
+	relabeled->directed = graph->directed;
+	relabeled->offset = (long *)malloc( (num_vertex + 2) * sizeof(long));
+	relabeled->adj = (int *)malloc( (total ? total : 1) * sizeof(int));
+	if (graph->weight) relabeled->weight = (int *)malloc( (total ? total : 1) * sizeof(int));
+	if (!relabeled->offset || !relabeled->adj || (graph->weight && !relabeled->weight))
+	{
+		graph_Destroy( relabeled);
+		return NULL;
+	}
+
+	// row of new vertex new_id[v] gets the degree of v
+	relabeled->offset[0] = relabeled->offset[1] = 0;
+	for (v = 1; v <= num_vertex; v++)
+		relabeled->offset[new_id[v] + 1] = graph_Degree( graph, v);
+	for (v = 1; v <= num_vertex; v++)
+		relabeled->offset[v + 1] += relabeled->offset[v];
+
+	for (v = 1; v <= num_vertex; v++)
+	{
+		long to = relabeled->offset[new_id[v]];
+		for (long e = graph->offset[v]; e < graph->offset[v + 1]; e++, to++)
+		{
+			relabeled->adj[to] = new_id[graph->adj[e]];
+			if (graph->weight) relabeled->weight[to] = graph->weight[e];
+		}
+	}
+
+	// rows are kept sorted; there are no duplicates to remove
+	for (v = 1; v <= num_vertex && ok; v++)
+		if (_sort_row( relabeled, v, &buf, &buf_size) < 0) ok = 0;
+
+	free( buf);
+	if (!ok)
+	{
+		graph_Destroy( relabeled);
+		return NULL;
+	}
+	return relabeled;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void graph_Destroy( GRAPH *graph)
+{
+	if (graph && graph->map)
+	{
+		munmap( graph->map, graph->map_size);
+		free( graph);
+	}
+	else if (graph)
+	{
+		free( graph->offset);
+		free( graph->adj);
+		free( graph->weight);
+		free( graph);
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int graph_Degree( GRAPH *graph, int v)
+{
+	return (int)(graph->offset[v + 1] - graph->offset[v]);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int graph_Weight( GRAPH *graph, int from, int to)
+{
+	long l = graph->offset[from], r = graph->offset[from + 1] - 1;
+
+	while (l <= r)
+	{
+		long m = (l + r) / 2;
+		if (graph->adj[m] < to) l = m + 1;
+		else if (graph->adj[m] > to) r = m - 1;
+		else return graph->weight ? graph->weight[m] : 1;
+	}
+	return 0;
+}
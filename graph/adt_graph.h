@@ -0,0 +1,79 @@
+////////////////////////////////////////////////////////////////////////////////
+// GRAPH type definition
+// compressed adjacency (CSR) : neighbors of vertex v are adj[offset[v]] .. adj[offset[v+1]-1]
+// vertex ids are 1 .. num_vertex (Pajek .net 방식), index 0 is unused
+typedef struct
+{
+	int		num_vertex;
+	long	num_edge;	// number of adjacency entries (an undirected edge is stored twice)
+	int		directed;	// 1 if loaded from *Arcs
+	long	*offset;	// num_vertex + 2 entries
+	int		*adj;		// num_edge entries, sorted ascending within each vertex
+	int		*weight;	// parallel to adj, NULL if unweighted
+	void	*map;		// mmap'd snapshot the arrays point into (read-only), NULL if allocated
+	long	map_size;
+} GRAPH;
+
+////////////////////////////////////////////////////////////////////////////////
+// function declarations
+
+/* Loads a Pajek .net file (*Vertices, *Edges / *Arcs with optional weights)
+	the file is mmap'd and parsed in two passes (degree count, then fill)
+	num_thread > 1 parses the edge lines in parallel chunks
+	duplicated edges are merged (the smallest weight is kept)
+	a binary snapshot written by graph_Save is recognized and mmap'd without parsing
+	(its header and offsets are checked, the neighbour ids only by graph_Check)
+	return	graph pointer
+			NULL if the file cannot be read or has a format error
+*/
+GRAPH *graph_Load( char *filename, int num_thread);
+
+/* Writes graph as a binary snapshot
+	layout	header (32 bytes), offset[num_vertex+2] (long), adj[num_edge] (int), weight[num_edge] (int, if weighted)
+	in host byte order
+	return	1 success
+			0 write error
+*/
+int graph_Save( GRAPH *graph, char *filename);
+
+/* Checks that every neighbour id is a vertex (1 .. num_vertex), O(E)
+	for a snapshot from an untrusted source
+	return	1 valid
+			0 corrupt
+*/
+int graph_Check( GRAPH *graph);
+
+/* returns number of vertices declared in a .net file or a snapshot
+			-1 if the file cannot be read or has a format error
+*/
+int graph_Vertices( char *filename);
+
+/* Passes every edge of a .net file or a snapshot to callback without building adjacency
+	callback is called concurrently from num_thread threads
+	weight is 1 for an unweighted edge
+	an undirected edge of a snapshot is passed once
+	return	number of edges passed to callback
+			-1 if the file cannot be read or has a format error
+*/
+long graph_ScanEdges( char *filename, int num_thread, void (*callback)(int from, int to, int weight, void *arg), void *arg);
+
+/* Builds a copy of graph with vertex v renamed to new_id[v]
+	new_id must be a permutation of 1 .. num_vertex
+	return	relabeled graph
+			NULL if overflow
+*/
+GRAPH *graph_Relabel( GRAPH *graph, int *new_id);
+
+/* Free memory for graph
+*/
+void graph_Destroy( GRAPH *graph);
+
+/* returns number of neighbors of vertex v
+*/
+int graph_Degree( GRAPH *graph, int v);
+
+/* returns weight of edge (from, to)
+			0 if there is no such edge
+			1 if the graph is unweighted and the edge exists
+*/
+int graph_Weight( GRAPH *graph, int from, int to);
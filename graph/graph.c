@@ -1,188 +1,466 @@
-#include <stdio.h>
-#include <string.h>
-#include <stdlib.h>
-#include <assert.h>
-
-// 깊이 우선 순회
-void depth_first_Traversal(int *graph, int num_vertex)
-{
-    int *visited = (int *)calloc(num_vertex + 1, sizeof(int));
-    int *stack = (int *)malloc((num_vertex + 1) * sizeof(int));
-    int top = -1;
-
-    for (int start = 1; start <= num_vertex; start++) {
-        if (!visited[start]) {
-            stack[++top] = start;
-            visited[start] = 1; 
-
-            while (top != -1) {
-                int vertex = stack[top--];
-                // printf("Pop from stack: %d\n", vertex);
-
-                // printf("Visit: %d\n", vertex);
-				printf("%d ", vertex);
-
-                for (int i = 1; i <= num_vertex; i++) {
-                    if (*(graph + (vertex ) * num_vertex + (i )) == 1 && !visited[i]) {
-                        // printf("Visited: %d\n", visited[i]);
-                        stack[++top] = i;
-                        visited[i] = 1; 
-                        // printf("Push to stack: %d\n", i);
-                    }
-                }
-                
-                // printf("Current stack: ");
-                // for (int i = 0; i <= top; i++) {
-                //     printf("%d ", stack[i]);
-                // }
-                // printf("\n");
-                // printf("Visited nodes: ");
-                // for (int i = 1; i <= num_vertex; i++) {
-                //     printf("%d ", visited[i]);
-                // }
-                // printf("\n");
-            }
-        }
-    }
-
-    free(visited);
-    free(stack);
-    printf("\n");
-}
-
-
-// 너비 우선 순회
-void breadth_first_Traversal(int *graph, int num_vertex)
-{
-    int *visited = (int *)calloc(num_vertex + 1, sizeof(int));
-    int *queue = (int *)malloc((num_vertex + 1) * sizeof(int));
-    int front = 0, rear = 0;
-
-    for (int start = 1; start <= num_vertex; start++) {
-        if (!visited[start]) {
-            queue[rear++] = start;
-            visited[start] = 1;
-
-            while (front != rear) {
-                int vertex = queue[front++];
-                // printf("Dequeue: %d\n", vertex);
-                // printf("Visit: %d\n", vertex);
-
-				printf("%d ", vertex);
-
-                for (int i = 1; i <= num_vertex; i++) {
-                    if (*(graph + (vertex) * num_vertex + (i)) == 1 && !visited[i]) {
-                        queue[rear++] = i;
-                        visited[i] = 1;
-                        // printf("Enqueue: %d\n", i);
-                    }
-                }
-                // printf("Current queue: ");
-                // for (int i = front; i < rear; i++) {
-                //     printf("%d ", queue[i]);
-                // }
-                // printf("\n");
-                // printf("Visited nodes: ");
-                // for (int i = 1; i <= num_vertex; i++) {
-                //     printf("%d ", visited[i]);
-                // }
-                // printf("\n");
-            }
-        }
-    }
-
-    free(visited);
-    free(queue);
-    printf("\n");
-}
-
-
-
-
-////////////////////////////////////////////////////////////////////////////////
-int *load_graph( char *filename, int *num_vertex)
-{
-	char str[100];
-	int num;
-	int from, to;
-	
-	FILE *fp = fopen( filename, "r");
-	if (fp == NULL)
-	{
-		printf( "Error: cannot open file [%s]\n", filename);
-		return NULL;
-	}
-	
-	fscanf( fp, "%s%d", str, &num);
-	assert( num > 0);
-	assert( strcmp( str, "*Vertices") == 0);
-	
-	int *graph = (int *)calloc( (num+1) * (num+1), sizeof(int));
-	
-	if (graph == NULL) return NULL;
-	
-	fscanf( fp, "%s", str);
-	assert( strcmp( str, "*Edges") == 0);
-	
-	int ret;
-	
-	while( 2 == fscanf( fp, "%d%d", &from, &to))
-	{
-		*(graph + from * num + to) = 1; // graph[from][to]
-		*(graph + to * num + from) = 1;
-	}
-	
-	fclose( fp);
-
-	*num_vertex = num;
-	
-	return graph;
-}
-
-////////////////////////////////////////////////////////////////////////////////
-void print_graph( int *graph, int num)
-{
-	int i, j;
-	
-	for (i = 1; i <= num; i++)
-	{
-		for (j = 1; j <= num; j++)
-			printf( "%d\t", *(graph + i * num + j));
-		
-		printf( "\n");
-	}
-}
-
-////////////////////////////////////////////////////////////////////////////////
-int main( int argc, char **argv)
-{
-	int *graph;
-	int num_vertex = 0;
-
-	if (argc != 2)
-	{
-		printf( "Usage: %s FILE(.net)\n", argv[0]);
-		return 2;
-	}
-
-	// .net 파일 읽어서 adjacent matrix로 저장
-	// (num_vertex+1) * (num_vertex+1)의 2차원 배열
-	graph = load_graph( argv[1], &num_vertex);
-	if (graph == NULL) return 0;
-	
-	// 그래프 출력
-	print_graph( graph, num_vertex);
-
-	// 각각 스택과 큐를 사용
-	// 배열을 사용하나, 스택이나 큐에 포함될 원소의 수는 정점의 수와 동일하므로 overflow 상태가 될 위험이 없음
-	printf( "DFS : ");
-	depth_first_Traversal( graph, num_vertex);
-
-	printf( "BFS : ");
-	breadth_first_Traversal( graph, num_vertex);
-	
-	free( graph);
-	
-	return 0;
-}
-
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <time.h> // clock_gettime
+
+#include "adt_graph.h"
+#include "graph_cc.h"
+#include "graph_sp.h"
+#include "graph_order.h"
+#include "outbuf.h"
+
+// 깊이 우선 순회 (outbuf로 출력)
+// label : 출력할 원래 정점 번호 (재배치된 그래프인 경우), NULL이면 정점 번호 그대로 출력
+void depth_first_Traversal(GRAPH *graph, int *label)
+{
+    int num_vertex = graph->num_vertex;
+    int *visited = (int *)calloc(num_vertex + 1, sizeof(int));
+    int *stack = (int *)malloc((num_vertex + 1) * sizeof(int));
+    int top = -1;
+
+    for (int start = 1; start <= num_vertex; start++) {
+        if (!visited[start]) {
+            stack[++top] = start;
+            visited[start] = 1; 
+
+            while (top != -1) {
+                int vertex = stack[top--];
+                // printf("Pop from stack: %d\n", vertex);
+
+                // printf("Visit: %d\n", vertex);
+				out_int(label ? label[vertex] : vertex);
+				out_char(' ');
+
+                // 인접 정점은 번호 오름차순으로 저장되어 있음
+                for (long e = graph->offset[vertex]; e < graph->offset[vertex + 1]; e++) {
+                    int i = graph->adj[e];
+                    if (!visited[i]) {
+                        // printf("Visited: %d\n", visited[i]);
+                        stack[++top] = i;
+                        visited[i] = 1; 
+                        // printf("Push to stack: %d\n", i);
+                    }
+                }
+                
+                // printf("Current stack: ");
+                // for (int i = 0; i <= top; i++) {
+                //     printf("%d ", stack[i]);
+                // }
+                // printf("\n");
+                // printf("Visited nodes: ");
+                // for (int i = 1; i <= num_vertex; i++) {
+                //     printf("%d ", visited[i]);
+                // }
+                // printf("\n");
+            }
+        }
+    }
+
+    free(visited);
+    free(stack);
+    out_char('\n');
+    out_flush();
+}
+
+
+// 너비 우선 순회 (outbuf로 출력)
+void breadth_first_Traversal(GRAPH *graph, int *label)
+{
+    int num_vertex = graph->num_vertex;
+    int *visited = (int *)calloc(num_vertex + 1, sizeof(int));
+    int *queue = (int *)malloc((num_vertex + 1) * sizeof(int));
+    int front = 0, rear = 0;
+
+    for (int start = 1; start <= num_vertex; start++) {
+        if (!visited[start]) {
+            queue[rear++] = start;
+            visited[start] = 1;
+
+            while (front != rear) {
+                int vertex = queue[front++];
+                // printf("Dequeue: %d\n", vertex);
+                // printf("Visit: %d\n", vertex);
+
+				out_int(label ? label[vertex] : vertex);
+				out_char(' ');
+
+                for (long e = graph->offset[vertex]; e < graph->offset[vertex + 1]; e++) {
+                    int i = graph->adj[e];
+                    if (!visited[i]) {
+                        queue[rear++] = i;
+                        visited[i] = 1;
+                        // printf("Enqueue: %d\n", i);
+                    }
+                }
+                // printf("Current queue: ");
+                // for (int i = front; i < rear; i++) {
+                //     printf("%d ", queue[i]);
+                // }
+                // printf("\n");
+                // printf("Visited nodes: ");
+                // for (int i = 1; i <= num_vertex; i++) {
+                //     printf("%d ", visited[i]);
+                // }
+                // printf("\n");
+            }
+        }
+    }
+
+    free(visited);
+    free(queue);
+    out_char('\n');
+    out_flush();
+}
+
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+// prints adjacent matrix
+void print_graph( GRAPH *graph)
+{
+	int i, j;
+	int num = graph->num_vertex;
+	
+	for (i = 1; i <= num; i++)
+	{
+		long e = graph->offset[i];
+		
+		for (j = 1; j <= num; j++)
+		{
+			// 행의 인접 정점 목록은 정렬되어 있으므로 순서대로 맞춰 나감
+			if (e < graph->offset[i + 1] && graph->adj[e] == j)
+			{
+				out_str( "1\t");
+				e++;
+			}
+			else out_str( "0\t");
+		}
+		
+		out_char( '\n');
+	}
+	out_flush();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 연결 요소 출력
+// 정점별 요소 번호와 요소별 정점 수
+void print_components( int *comp, int num_vertex, int num_component)
+{
+	int *size = component_Size( comp, num_vertex, num_component);
+
+	printf( "Components : %d\n", num_component);
+	out_str( "CC : ");
+	for (int v = 1; v <= num_vertex; v++)
+	{
+		out_int( comp[v]);
+		out_char( ' ');
+	}
+	out_char( '\n');
+
+	if (size)
+	{
+		out_str( "Size : ");
+		for (int c = 1; c <= num_component; c++)
+		{
+			out_int( size[c]);
+			out_char( ' ');
+		}
+		out_char( '\n');
+	}
+	out_flush();
+	free( size);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 최단 경로 거리 출력 (도달 불가능한 정점은 '-')
+void print_distance( long long *dist, int num_vertex)
+{
+	for (int v = 1; v <= num_vertex; v++)
+	{
+		if (dist[v] == SP_INFINITY) out_char( '-');
+		else out_int( dist[v]);
+		out_char( ' ');
+	}
+	out_char( '\n');
+	out_flush();
+}
+
+// 경과 시간 (초)
+static double elapsed( struct timespec *start)
+{
+	struct timespec now;
+	clock_gettime( CLOCK_MONOTONIC, &now);
+	return (now.tv_sec - start->tv_sec) + (now.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+// 재배치된 그래프의 결과를 원래 정점 번호 순서로 옮김
+// result[v] = values[new_id[v]]
+static void *remap( void *values, size_t size, int *new_id, int num_vertex)
+{
+	char *result = (char *)malloc( (num_vertex + 1) * size);
+	if (result)
+	{
+		memcpy( result, values, size); // index 0
+		for (int v = 1; v <= num_vertex; v++)
+			memcpy( result + v * size, (char *)values + new_id[v] * size, size);
+	}
+	free( values);
+	return result;
+}
+
+// 원래 정점 순서에서 처음 나오는 순서대로 요소 번호를 다시 매김
+static void renumber_components( int *comp, int num_vertex, int num_component)
+{
+	int *number = (int *)calloc( num_component + 1, sizeof(int));
+	int count = 0;
+
+	if (!number) return;
+	for (int v = 1; v <= num_vertex; v++)
+	{
+		if (!number[comp[v]]) number[comp[v]] = ++count;
+		comp[v] = number[comp[v]];
+	}
+	free( number);
+}
+
+// return	1 if an edge weight is negative (the solvers return NULL)
+static int negative_weight( GRAPH *graph)
+{
+	if (graph->weight)
+		for (long e = 0; e < graph->num_edge; e++)
+			if (graph->weight[e] < 0) return 1;
+	return 0;
+}
+
+// 단일 출발점 최단 경로
+// algorithm : dijkstra (indexed heap), radix, heap (adt_heap), delta, all (모두 실행하여 시간 비교)
+// new_id : 재배치된 그래프인 경우 원래 정점 번호 -> 새 번호, NULL이면 재배치 없음
+void shortest_path( GRAPH *graph, int source, char *algorithm, long long delta, int num_thread, int *new_id)
+{
+	static char *names[] = { "dijkstra", "radix", "heap", "delta"};
+	long long *first = NULL;
+	char *first_name = NULL;
+	int all = (strcmp( algorithm, "all") == 0), known = all;
+
+	for (int i = 0; i < 4; i++) known |= (strcmp( algorithm, names[i]) == 0);
+	if (!known)
+	{
+		fprintf( stderr, "Error: unknown algorithm : %s\n", algorithm);
+		return;
+	}
+	if (source < 1 || source > graph->num_vertex)
+	{
+		fprintf( stderr, "Error: source %d is not a vertex (1 .. %d)\n", source, graph->num_vertex);
+		return;
+	}
+	if (negative_weight( graph))
+	{
+		fprintf( stderr, "Error: negative edge weight\n");
+		return;
+	}
+
+	for (int i = 0; i < 4; i++)
+	{
+		struct timespec start;
+		long long *dist;
+
+		if (!all && strcmp( algorithm, names[i]) != 0) continue;
+
+		clock_gettime( CLOCK_MONOTONIC, &start);
+		int from = new_id ? new_id[source] : source;
+		switch (i)
+		{
+			case 0: dist = sp_Dijkstra( graph, from); break;
+			case 1: dist = sp_DijkstraRadix( graph, from); break;
+			case 2: dist = sp_DijkstraHeap( graph, from); break;
+			default: dist = sp_DeltaStepping( graph, from, delta, num_thread); break;
+		}
+		if (dist && new_id) dist = remap( dist, sizeof(long long), new_id, graph->num_vertex);
+		if (dist == NULL)
+		{
+			fprintf( stderr, "Error: %s : overflow\n", names[i]);
+			break;
+		}
+
+		fprintf( stderr, "%s : %.3f sec\n", names[i], elapsed( &start));
+
+		if (first == NULL)
+		{
+			first = dist;
+			first_name = names[i];
+			printf( "SP(%d) : ", source);
+			print_distance( dist, graph->num_vertex);
+			continue;
+		}
+
+		// 모든 알고리즘의 결과는 같아야 함
+		if (memcmp( first, dist, (graph->num_vertex + 1) * sizeof(long long)) != 0)
+			fprintf( stderr, "%s : distances differ from %s\n", names[i], first_name);
+		free( dist);
+	}
+
+	free( first);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int main( int argc, char **argv)
+{
+	GRAPH *graph;
+	char *filename = NULL;
+	char *snapshot = NULL;
+	char *cc_mode = NULL;
+	char *algorithm = "dijkstra";
+	int source = 0;
+	long long delta = 0;
+	char *order = NULL;
+	int num_thread = 1;
+	int quiet = 0;
+	int verify = 0;
+	GRAPH *work; // 순회와 분석에 사용하는 그래프 (-r 재배치 시 새 번호의 그래프)
+	int *new_id = NULL, *old_id = NULL;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp( argv[i], "-t") == 0 && i + 1 < argc) num_thread = atoi( argv[++i]);
+		else if (strcmp( argv[i], "-w") == 0 && i + 1 < argc) snapshot = argv[++i];
+		else if (strcmp( argv[i], "-c") == 0 && i + 1 < argc) cc_mode = argv[++i];
+		else if (strcmp( argv[i], "-s") == 0 && i + 1 < argc) source = atoi( argv[++i]);
+		else if (strcmp( argv[i], "-a") == 0 && i + 1 < argc) algorithm = argv[++i];
+		else if (strcmp( argv[i], "-d") == 0 && i + 1 < argc) delta = atoll( argv[++i]);
+		else if (strcmp( argv[i], "-r") == 0 && i + 1 < argc) order = argv[++i];
+		else if (strcmp( argv[i], "-q") == 0) quiet = 1;
+		else if (strcmp( argv[i], "-V") == 0) verify = 1;
+		else if (filename == NULL) filename = argv[i];
+		else
+		{
+			fprintf( stderr, "Error: more than one FILE [%s]\n", argv[i]);
+			filename = NULL;
+			break;
+		}
+	}
+
+	// -c, -r : 알 수 없는 값이면 사용법 출력
+	if (cc_mode && strcmp( cc_mode, "bfs") != 0 && strcmp( cc_mode, "uf") != 0 && strcmp( cc_mode, "stream") != 0)
+	{
+		fprintf( stderr, "Error: unknown component mode : %s\n", cc_mode);
+		filename = NULL;
+	}
+	if (order && strcmp( order, "rcm") != 0 && strcmp( order, "bfs") != 0 && strcmp( order, "degree") != 0)
+	{
+		fprintf( stderr, "Error: unknown order : %s\n", order);
+		filename = NULL;
+	}
+
+	if (filename == NULL)
+	{
+		printf( "Usage: %s [-q] [-V] [-t threads] [-w snapshot] [-c bfs|uf|stream] [-s source [-a dijkstra|radix|heap|delta|all] [-d delta]] [-r rcm|bfs|degree] FILE(.net or snapshot)\n", argv[0]);
+		return 2;
+	}
+
+	// 연결 요소만 구함 (인접 리스트를 만들지 않고 간선을 읽으면서 union-find)
+	if (cc_mode && strcmp( cc_mode, "stream") == 0)
+	{
+		int num_vertex, num_component;
+		int *comp = component_UnionFindFile( filename, num_thread, &num_vertex, &num_component);
+		
+		if (comp == NULL) return 0;
+		print_components( comp, num_vertex, num_component);
+		free( comp);
+		return 0;
+	}
+
+	// .net 파일을 mmap하여 읽고 인접 리스트(CSR)로 저장
+	// 정점 v의 인접 정점: adj[offset[v]] ~ adj[offset[v+1]-1]
+	// graph_Save로 저장한 스냅샷 파일은 파싱 없이 바로 mmap됨
+	graph = graph_Load( filename, num_thread);
+	if (graph == NULL) return 0;
+
+	// 스냅샷의 인접 정점 번호 검사 (-V) : 신뢰할 수 없는 스냅샷 파일
+	if (verify && !graph_Check( graph))
+	{
+		fprintf( stderr, "Error: invalid .net or snapshot format [%s]\n", filename);
+		graph_Destroy( graph);
+		return 0;
+	}
+
+	// 바이너리 스냅샷 저장 (-w)
+	if (snapshot && !graph_Save( graph, snapshot))
+	{
+		fprintf( stderr, "Error: cannot write snapshot [%s]\n", snapshot);
+	}
+	
+	// 정점 번호 재배치 (-r) : 순회 시 메모리 접근이 가까운 곳에서 일어나도록 번호를 다시 매김
+	// 결과는 원래 번호로 출력
+	work = graph;
+	if (order)
+	{
+		if (strcmp( order, "rcm") == 0) new_id = order_RCM( graph);
+		else if (strcmp( order, "bfs") == 0) new_id = order_BFS( graph);
+		else new_id = order_Degree( graph);
+
+		if (new_id)
+		{
+			old_id = order_Inverse( new_id, graph->num_vertex);
+			work = graph_Relabel( graph, new_id);
+		}
+		if (!old_id || !work)
+		{
+			if (work) graph_Destroy( work);
+			work = graph;
+			free( new_id);
+			free( old_id);
+			new_id = old_id = NULL;
+		}
+		else
+		{
+			double before = order_TraversalTime( graph, 3);
+			double after = order_TraversalTime( work, 3);
+			fprintf( stderr, "reorder (%s) : BFS %.3f sec -> %.3f sec (x%.2f)\n", order, before, after, after > 0 ? before / after : 0);
+		}
+	}
+	
+	// 그래프 출력 (-q : 큰 그래프에서는 인접 행렬과 순회 결과 출력 생략)
+	if (!quiet)
+	{
+		print_graph( graph);
+
+		// 각각 스택과 큐를 사용
+		// 배열을 사용하나, 스택이나 큐에 포함될 원소의 수는 정점의 수와 동일하므로 overflow 상태가 될 위험이 없음
+		printf( "DFS : ");
+		depth_first_Traversal( work, old_id);
+
+		printf( "BFS : ");
+		breadth_first_Traversal( work, old_id);
+	}
+
+	// 연결 요소 (-c bfs : 너비 우선 탐색, -c uf : union-find)
+	if (cc_mode)
+	{
+		int num_component;
+		int *comp = (strcmp( cc_mode, "uf") == 0)
+			? component_UnionFind( work, num_thread, &num_component)
+			: component_BFS( work, &num_component);
+		
+		if (comp && new_id)
+		{
+			comp = remap( comp, sizeof(int), new_id, work->num_vertex);
+			if (comp) renumber_components( comp, work->num_vertex, num_component);
+		}
+		if (comp) print_components( comp, work->num_vertex, num_component);
+		free( comp);
+	}
+
+	// 최단 경로 (-s 출발 정점)
+	if (source) // shortest_path reports a source that is not a vertex
+	{
+		shortest_path( work, source, algorithm, delta, num_thread, new_id);
+	}
+	
+	if (work != graph) graph_Destroy( work);
+	graph_Destroy( graph);
+	free( new_id);
+	free( old_id);
+	
+	return 0;
+}
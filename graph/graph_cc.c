@@ -0,0 +1,211 @@
+#include <stdlib.h> // malloc, calloc
+#include <pthread.h>
+
+#include "adt_graph.h"
+#include "graph_cc.h"
+
+#define MAX_THREAD	64
+
+// arguments of a union-find thread on the adjacency
+typedef struct
+{
+	GRAPH	*graph;
+	int		*parent;
+	int		tid;
+	int		num_thread;
+} UF_WORKER;
+
+////////////////////////////////////////////////////////////////////////////////
+// lock-free union-find
+// a root always links under a smaller root, so the root of a set is its smallest vertex
+// and concurrent links can never make a cycle
+
+// returns root of x
+// path halving : parent[x] is moved to its grandparent with CAS, a lost race is harmless
+static int _find( int *parent, int x)
+{
+	int p, gp;
+
+	while ((p = __atomic_load_n( &parent[x], __ATOMIC_RELAXED)) != x)
+	{
+		gp = __atomic_load_n( &parent[p], __ATOMIC_RELAXED);
+		if (p != gp)
+			__atomic_compare_exchange_n( &parent[x], &p, gp, 0, __ATOMIC_RELAXED, __ATOMIC_RELAXED);
+		x = gp;
+	}
+	return x;
+}
+
+// merges sets of a and b
+// the CAS fails if the larger root got a parent meanwhile, then both roots are found again
+static void _union( int *parent, int a, int b)
+{
+	while (1)
+	{
+		a = _find( parent, a);
+		b = _find( parent, b);
+		if (a == b) return;
+
+		if (a > b)
+		{
+			int temp = a;
+			a = b;
+			b = temp;
+		}
+
+		int expected = b;
+		if (__atomic_compare_exchange_n( &parent[b], &expected, a, 0, __ATOMIC_RELEASE, __ATOMIC_RELAXED))
+			return;
+	}
+}
+
+// allocates parent array with every vertex as its own set
+static int *_make_sets( int num_vertex)
+{
+	int *parent = (int *)malloc( (num_vertex + 1) * sizeof(int));
+	if (parent)
+		for (int v = 0; v <= num_vertex; v++) parent[v] = v;
+	return parent;
+}
+
+// converts parents into component numbers in place (after all unions are done)
+// parent[v] <= v always holds, so when v is reached parent[v] has already been
+// replaced by the component number of its set
+// roots are the smallest vertices, so numbering in vertex order gives the BFS numbering
+static int _label( int *parent, int num_vertex)
+{
+	int num_component = 0;
+
+	for (int v = 1; v <= num_vertex; v++)
+	{
+		if (parent[v] == v) parent[v] = ++num_component;
+		else parent[v] = parent[parent[v]];
+	}
+	return num_component;
+}
+
+static void *_union_thread( void *arg)
+{
+	UF_WORKER *w = (UF_WORKER *)arg;
+	GRAPH *graph = w->graph;
+
+	for (int v = w->tid + 1; v <= graph->num_vertex; v += w->num_thread)
+		for (long e = graph->offset[v]; e < graph->offset[v + 1]; e++)
+			if (graph->directed || graph->adj[e] > v) _union( w->parent, v, graph->adj[e]);
+
+	return NULL;
+}
+
+// for graph_ScanEdges
+static void _union_edge( int from, int to, int weight, void *arg)
+{
+	(void)weight;
+	_union( (int *)arg, from, to);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int *component_BFS( GRAPH *graph, int *num_component)
+{
+	int num_vertex = graph->num_vertex;
+	int *comp, *queue;
+	int count = 0;
+
+	// arcs are followed one way only, so a later start could reach an earlier component
+	if (graph->directed) return component_UnionFind( graph, 1, num_component);
+
+	comp = (int *)calloc( num_vertex + 1, sizeof(int));
+	queue = (int *)malloc( (num_vertex + 1) * sizeof(int));
+	if (!comp || !queue)
+	{
+		free( comp);
+		free( queue);
+		return NULL;
+	}
+
+	for (int start = 1; start <= num_vertex; start++)
+	{
+		if (comp[start]) continue;
+
+		int front = 0, rear = 0;
+		queue[rear++] = start;
+		comp[start] = ++count;
+
+		while (front != rear)
+		{
+			int vertex = queue[front++];
+			for (long e = graph->offset[vertex]; e < graph->offset[vertex + 1]; e++)
+			{
+				int i = graph->adj[e];
+				if (!comp[i])
+				{
+					comp[i] = count;
+					queue[rear++] = i;
+				}
+			}
+		}
+	}
+
+	free( queue);
+	*num_component = count;
+	return comp;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int *component_UnionFind( GRAPH *graph, int num_thread, int *num_component)
+{
+	UF_WORKER workers[MAX_THREAD];
+	pthread_t tid[MAX_THREAD];
+	int *parent = _make_sets( graph->num_vertex);
+	int t, started = 0;
+
+	if (!parent) return NULL;
+	if (num_thread < 1) num_thread = 1;
+	if (num_thread > MAX_THREAD) num_thread = MAX_THREAD;
+
+	for (t = 0; t < num_thread; t++)
+	{
+		workers[t].graph = graph;
+		workers[t].parent = parent;
+		workers[t].tid = t;
+		workers[t].num_thread = num_thread;
+	}
+
+	for (t = 1; t < num_thread; t++)
+	{
+		if (pthread_create( &tid[t], NULL, _union_thread, &workers[t]) != 0) break;
+		started = t;
+	}
+	_union_thread( &workers[0]);
+	for (t = started + 1; t < num_thread; t++) _union_thread( &workers[t]);
+	for (t = 1; t <= started; t++) pthread_join( tid[t], NULL);
+
+	*num_component = _label( parent, graph->num_vertex);
+	return parent;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int *component_UnionFindFile( char *filename, int num_thread, int *num_vertex, int *num_component)
+{
+	int *parent;
+
+	if ((*num_vertex = graph_Vertices( filename)) < 0) return NULL;
+	if ((parent = _make_sets( *num_vertex)) == NULL) return NULL;
+
+	if (graph_ScanEdges( filename, num_thread, _union_edge, parent) < 0)
+	{
+		free( parent);
+		return NULL;
+	}
+
+	*num_component = _label( parent, *num_vertex);
+	return parent;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int *component_Size( int *comp, int num_vertex, int num_component)
+{
+	int *size = (int *)calloc( num_component + 1, sizeof(int));
+	if (size)
+		for (int v = 1; v <= num_vertex; v++) size[comp[v]]++;
+	return size;
+}
@@ -0,0 +1,35 @@
+////////////////////////////////////////////////////////////////////////////////
+// connected components
+// component numbers are 1, 2, ... in order of the smallest vertex of each component,
+// so every labeling function returns the same comp array for the same graph
+// (for *Arcs the direction of arcs is ignored : weakly connected components)
+
+////////////////////////////////////////////////////////////////////////////////
+// function declarations
+
+/* Labels components by breadth first search on the adjacency
+	comp[v] (v = 1 .. num_vertex) receives the component number of v
+	return	comp array (num_vertex + 1 entries)
+			NULL if overflow
+*/
+int *component_BFS( GRAPH *graph, int *num_component);
+
+/* Labels components with a lock-free union-find over the adjacency
+	num_thread threads union the edges of disjoint vertex sets
+	return	comp array (num_vertex + 1 entries)
+			NULL if overflow
+*/
+int *component_UnionFind( GRAPH *graph, int num_thread, int *num_component);
+
+/* Labels components with a lock-free union-find over the edge lines of a .net file or a snapshot
+	adjacency is never built, memory is one int per vertex
+	return	comp array (num_vertex + 1 entries), number of vertices in *num_vertex
+			NULL if the file cannot be read or overflow
+*/
+int *component_UnionFindFile( char *filename, int num_thread, int *num_vertex, int *num_component);
+
+/* Counts vertices of each component
+	return	size array (num_component + 1 entries, size[c] for c = 1 .. num_component)
+			NULL if overflow
+*/
+int *component_Size( int *comp, int num_vertex, int num_component);
@@ -0,0 +1,258 @@
+#include <stdlib.h> // malloc, calloc, qsort
+#include <time.h> // clock_gettime
+
+#include "adt_graph.h"
+#include "graph_order.h"
+
+// (degree, vertex) pair used when sorting neighbors by degree
+typedef struct
+{
+	int	degree;
+	int	vertex;
+} DEG_PAIR;
+
+static int _compare_degree( const void *p1, const void *p2)
+{
+	const DEG_PAIR *a = (const DEG_PAIR *)p1;
+	const DEG_PAIR *b = (const DEG_PAIR *)p2;
+
+	if (a->degree != b->degree) return (a->degree > b->degree) - (a->degree < b->degree);
+	return (a->vertex > b->vertex) - (a->vertex < b->vertex);
+}
+
+// vertices sorted by degree (counting sort, stable by id)
+// ascending 1 : increasing degree, 0 : decreasing
+static int *_sort_by_degree( GRAPH *graph, int ascending)
+{
+	int num_vertex = graph->num_vertex;
+	int max_degree = 0;
+	int *sorted = (int *)malloc( num_vertex * sizeof(int));
+	long *start;
+	int v;
+
+	if (!sorted) return NULL;
+	for (v = 1; v <= num_vertex; v++)
+		if (graph_Degree( graph, v) > max_degree) max_degree = graph_Degree( graph, v);
+
+	start = (long *)calloc( max_degree + 2, sizeof(long));
+	if (!start)
+	{
+		free( sorted);
+		return NULL;
+	}
+
+	for (v = 1; v <= num_vertex; v++)
+	{
+		int d = graph_Degree( graph, v);
+		start[(ascending ? d : max_degree - d) + 1]++;
+	}
+	for (int d = 1; d <= max_degree + 1; d++) start[d] += start[d - 1];
+	for (v = 1; v <= num_vertex; v++)
+	{
+		int d = graph_Degree( graph, v);
+		sorted[start[ascending ? d : max_degree - d]++] = v;
+	}
+
+	free( start);
+	return sorted;
+}
+
+// new_id from a visiting order (order[i] gets id i+1)
+static int *_ids_from_order( int *order, int num_vertex)
+{
+	int *new_id = (int *)malloc( (num_vertex + 1) * sizeof(int));
+	if (new_id)
+	{
+		new_id[0] = 0;
+		for (int i = 0; i < num_vertex; i++) new_id[order[i]] = i + 1;
+	}
+	return new_id;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int *order_RCM( GRAPH *graph)
+{
+	int num_vertex = graph->num_vertex;
+	int *start = _sort_by_degree( graph, 1);
+	int *queue = (int *)malloc( num_vertex * sizeof(int));
+	char *visited = (char *)calloc( num_vertex + 1, 1);
+	DEG_PAIR *buf = NULL;
+	long buf_size = 0;
+	int *new_id = NULL;
+	int front = 0, rear = 0;
+
+	if (!start || !queue || !visited) goto cleanup;
+
+	for (int s = 0; s < num_vertex; s++)
+	{
+		if (visited[start[s]]) continue;
+
+		queue[rear++] = start[s];
+		visited[start[s]] = 1;
+
+		while (front != rear)
+		{
+			int vertex = queue[front++];
+			long n = 0;
+
+			if (buf_size < graph_Degree( graph, vertex))
+			{
+				DEG_PAIR *temp = (DEG_PAIR *)realloc( buf, graph_Degree( graph, vertex) * sizeof(DEG_PAIR));
+				if (!temp) goto cleanup;
+				buf = temp;
+				buf_size = graph_Degree( graph, vertex);
+			}
+
+			for (long e = graph->offset[vertex]; e < graph->offset[vertex + 1]; e++)
+			{
+				int i = graph->adj[e];
+				if (visited[i]) continue;
+				visited[i] = 1;
+				buf[n].degree = graph_Degree( graph, i);
+				buf[n].vertex = i;
+				n++;
+			}
+
+			// 차수가 작은 이웃부터 큐에 넣음
+			qsort( buf, n, sizeof(DEG_PAIR), _compare_degree);
+			for (long k = 0; k < n; k++) queue[rear++] = buf[k].vertex;
+		}
+	}
+
+	// reverse
+	for (int i = 0, j = num_vertex - 1; i < j; i++, j--)
+	{
+		int temp = queue[i];
+		queue[i] = queue[j];
+		queue[j] = temp;
+	}
+	new_id = _ids_from_order( queue, num_vertex);
+
+cleanup:
+	free( start);
+	free( queue);
+	free( visited);
+	free( buf);
+	return new_id;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int *order_BFS( GRAPH *graph)
+{
+	int num_vertex = graph->num_vertex;
+	int *queue = (int *)malloc( num_vertex * sizeof(int));
+	char *visited = (char *)calloc( num_vertex + 1, 1);
+	int *new_id = NULL;
+	int front = 0, rear = 0;
+
+	if (queue && visited)
+	{
+		for (int s = 1; s <= num_vertex; s++)
+		{
+			if (visited[s]) continue;
+
+			queue[rear++] = s;
+			visited[s] = 1;
+
+			while (front != rear)
+			{
+				int vertex = queue[front++];
+				for (long e = graph->offset[vertex]; e < graph->offset[vertex + 1]; e++)
+				{
+					int i = graph->adj[e];
+					if (!visited[i])
+					{
+						visited[i] = 1;
+						queue[rear++] = i;
+					}
+				}
+			}
+		}
+		new_id = _ids_from_order( queue, num_vertex);
+	}
+
+	free( queue);
+	free( visited);
+	return new_id;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int *order_Degree( GRAPH *graph)
+{
+	int *sorted = _sort_by_degree( graph, 0);
+	int *new_id = NULL;
+
+	if (sorted)
+	{
+		new_id = _ids_from_order( sorted, graph->num_vertex);
+		free( sorted);
+	}
+	return new_id;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int *order_Inverse( int *new_id, int num_vertex)
+{
+	int *old_id = (int *)malloc( (num_vertex + 1) * sizeof(int));
+	if (old_id)
+	{
+		old_id[0] = 0;
+		for (int v = 1; v <= num_vertex; v++) old_id[new_id[v]] = v;
+	}
+	return old_id;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+double order_TraversalTime( GRAPH *graph, int repeat)
+{
+	int num_vertex = graph->num_vertex;
+	int *queue = (int *)malloc( (num_vertex + 1) * sizeof(int));
+	char *visited = (char *)malloc( num_vertex + 1);
+	double best = -1;
+
+	if (!queue || !visited)
+	{
+		free( queue);
+		free( visited);
+		return -1;
+	}
+
+	for (int r = 0; r < repeat; r++)
+	{
+		struct timespec start, end;
+		int front = 0, rear = 0;
+
+		for (int v = 0; v <= num_vertex; v++) visited[v] = 0;
+
+		clock_gettime( CLOCK_MONOTONIC, &start);
+		for (int s = 1; s <= num_vertex; s++)
+		{
+			if (visited[s]) continue;
+
+			queue[rear++] = s;
+			visited[s] = 1;
+
+			while (front != rear)
+			{
+				int vertex = queue[front++];
+				for (long e = graph->offset[vertex]; e < graph->offset[vertex + 1]; e++)
+				{
+					int i = graph->adj[e];
+					if (!visited[i])
+					{
+						visited[i] = 1;
+						queue[rear++] = i;
+					}
+				}
+			}
+		}
+		clock_gettime( CLOCK_MONOTONIC, &end);
+
+		double t = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+		if (best < 0 || t < best) best = t;
+	}
+
+	free( queue);
+	free( visited);
+	return best;
+}
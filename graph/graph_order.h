@@ -0,0 +1,32 @@
+////////////////////////////////////////////////////////////////////////////////
+// vertex reordering for cache locality
+// each function returns new_id array (num_vertex + 1 entries) : vertex v becomes new_id[v]
+// the relabeled graph is built by graph_Relabel, and old_id (order_Inverse) maps results back
+// NULL is returned for overflow
+
+////////////////////////////////////////////////////////////////////////////////
+// function declarations
+
+/* reverse Cuthill-McKee
+	each component is searched breadth first from a vertex of minimum degree,
+	neighbors in increasing degree, and the whole order is reversed (small bandwidth)
+*/
+int *order_RCM( GRAPH *graph);
+
+/* breadth first visiting order (starts 1, 2, ... as in breadth_first_Traversal)
+*/
+int *order_BFS( GRAPH *graph);
+
+/* decreasing degree (hubs first), ties by vertex id
+*/
+int *order_Degree( GRAPH *graph);
+
+/* returns old_id array for new_id : old_id[new_id[v]] = v
+*/
+int *order_Inverse( int *new_id, int num_vertex);
+
+/* runs a breadth first search over all vertices without output
+	return	elapsed time in seconds (best of repeat runs)
+			-1 if overflow
+*/
+double order_TraversalTime( GRAPH *graph, int repeat);
@@ -0,0 +1,585 @@
+#include <stdio.h>
+#include <stdlib.h> // malloc, realloc, free
+#include <pthread.h>
+
+#include "adt_graph.h"
+#include "adt_heap.h"
+#include "graph_sp.h"
+
+#define MAX_THREAD		64
+#define PARALLEL_CUT	4096 // frontiers smaller than this are relaxed by the calling thread
+#define RADIX_BUCKET	65
+
+#define WEIGHT(graph, e)	((graph)->weight ? (graph)->weight[e] : 1)
+
+// growable array of vertices
+typedef struct
+{
+	int		*data;
+	long	len;
+	long	capacity;
+} IVEC;
+
+// indexed binary min-heap of vertices keyed by dist
+typedef struct
+{
+	int			*heap;	// heap[i] : vertex
+	int			*pos;	// pos[v] : index of v in heap, -1 if not in heap
+	long long	*key;	// dist array
+	int			size;
+} INDEX_HEAP;
+
+// (key, vertex) entry of a radix heap
+typedef struct
+{
+	unsigned long long	key;
+	int					vertex;
+} RADIX_ITEM;
+
+typedef struct
+{
+	RADIX_ITEM	*data;
+	long		len;
+	long		capacity;
+} RADIX_LIST;
+
+// radix heap : bucket i holds keys whose highest bit differing from last is bit i-1
+typedef struct
+{
+	RADIX_LIST			bucket[RADIX_BUCKET];
+	unsigned long long	last; // last extracted key
+	long				size;
+} RADIX_HEAP;
+
+// heap entry for adt_heap
+typedef struct
+{
+	long long	dist;
+	int			vertex;
+} SP_ENTRY;
+
+// arguments of a delta-stepping relaxation thread
+typedef struct
+{
+	GRAPH		*graph;
+	long long	*dist;
+	int			*items;
+	long		begin;
+	long		end;
+	int			light;	// 1 : edges with weight <= delta, 0 : heavier edges
+	long long	delta;
+	IVEC		out;	// vertices whose dist was lowered
+	int			error;
+} SP_WORKER;
+
+////////////////////////////////////////////////////////////////////////////////
+// common
+
+// allocates dist array (SP_INFINITY) after checking the weights
+static long long *_init_dist( GRAPH *graph, int source)
+{
+	long long *dist;
+
+	if (source < 1 || source > graph->num_vertex) return NULL;
+	if (graph->weight)
+	{
+		for (long e = 0; e < graph->num_edge; e++)
+		{
+			if (graph->weight[e] < 0) return NULL; // reported by the caller
+		}
+	}
+
+	dist = (long long *)malloc( (graph->num_vertex + 1) * sizeof(long long));
+	if (dist)
+		for (int v = 0; v <= graph->num_vertex; v++) dist[v] = SP_INFINITY;
+	return dist;
+}
+
+// appends v
+// return	1 success
+//			0 overflow
+static int _push( IVEC *vec, int v)
+{
+	if (vec->len == vec->capacity)
+	{
+		long capacity = vec->capacity ? vec->capacity * 2 : 16;
+		int *temp = (int *)realloc( vec->data, capacity * sizeof(int));
+		if (!temp) return 0;
+		vec->data = temp;
+		vec->capacity = capacity;
+	}
+	vec->data[vec->len++] = v;
+	return 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// indexed binary heap
+
+static void _swap( INDEX_HEAP *h, int i, int j)
+{
+	int temp = h->heap[i];
+	h->heap[i] = h->heap[j];
+	h->heap[j] = temp;
+	h->pos[h->heap[i]] = i;
+	h->pos[h->heap[j]] = j;
+}
+
+static void _up( INDEX_HEAP *h, int index)
+{
+	while (index)
+	{
+		int parent = (index - 1) / 2;
+		if (h->key[h->heap[index]] >= h->key[h->heap[parent]]) break;
+		_swap( h, index, parent);
+		index = parent;
+	}
+}
+
+static void _down( INDEX_HEAP *h, int index)
+{
+	while (1)
+	{
+		int child = 2 * index + 1;
+		if (child >= h->size) break;
+		if (child + 1 < h->size && h->key[h->heap[child + 1]] < h->key[h->heap[child]]) child++;
+		if (h->key[h->heap[child]] >= h->key[h->heap[index]]) break;
+		_swap( h, index, child);
+		index = child;
+	}
+}
+
+// inserts v or moves it up after its key decreased
+static void _decrease( INDEX_HEAP *h, int v)
+{
+	if (h->pos[v] < 0)
+	{
+		h->heap[h->size] = v;
+		h->pos[v] = h->size++;
+	}
+	_up( h, h->pos[v]);
+}
+
+static int _extract( INDEX_HEAP *h)
+{
+	int v = h->heap[0];
+
+	h->pos[v] = -1;
+	if (--h->size > 0)
+	{
+		h->heap[0] = h->heap[h->size];
+		h->pos[h->heap[0]] = 0;
+		_down( h, 0);
+	}
+	return v;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// radix heap
+
+static int _radix_index( unsigned long long key, unsigned long long last)
+{
+	return key == last ? 0 : 64 - __builtin_clzll( key ^ last);
+}
+
+static int _radix_append( RADIX_LIST *list, unsigned long long key, int v)
+{
+	if (list->len == list->capacity)
+	{
+		long capacity = list->capacity ? list->capacity * 2 : 16;
+		RADIX_ITEM *temp = (RADIX_ITEM *)realloc( list->data, capacity * sizeof(RADIX_ITEM));
+		if (!temp) return 0;
+		list->data = temp;
+		list->capacity = capacity;
+	}
+	list->data[list->len].key = key;
+	list->data[list->len].vertex = v;
+	list->len++;
+	return 1;
+}
+
+// key must not be smaller than the last extracted key
+static int _radix_push( RADIX_HEAP *h, unsigned long long key, int v)
+{
+	if (!_radix_append( &h->bucket[_radix_index( key, h->last)], key, v)) return 0;
+	h->size++;
+	return 1;
+}
+
+// extracts an item with the smallest key
+// the first non-empty bucket is redistributed around its minimum; every item moves to a lower bucket
+static int _radix_pop( RADIX_HEAP *h, unsigned long long *key)
+{
+	if (h->bucket[0].len == 0)
+	{
+		int i = 1;
+		while (h->bucket[i].len == 0) i++;
+
+		RADIX_LIST *list = &h->bucket[i];
+		unsigned long long min = list->data[0].key;
+		for (long k = 1; k < list->len; k++)
+			if (list->data[k].key < min) min = list->data[k].key;
+
+		h->last = min;
+		for (long k = 0; k < list->len; k++)
+		{
+			RADIX_ITEM item = list->data[k];
+			if (!_radix_append( &h->bucket[_radix_index( item.key, min)], item.key, item.vertex)) return -1;
+		}
+		list->len = 0;
+	}
+
+	h->size--;
+	h->bucket[0].len--;
+	*key = h->bucket[0].data[h->bucket[0].len].key;
+	return h->bucket[0].data[h->bucket[0].len].vertex;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// delta-stepping
+
+// lowers *p to value
+// return	1 if *p was lowered by this call
+static int _atomic_min( long long *p, long long value)
+{
+	long long current = __atomic_load_n( p, __ATOMIC_RELAXED);
+
+	while (value < current)
+		if (__atomic_compare_exchange_n( p, &current, value, 0, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+			return 1;
+	return 0;
+}
+
+static void *_relax_thread( void *arg)
+{
+	SP_WORKER *w = (SP_WORKER *)arg;
+	GRAPH *graph = w->graph;
+
+	for (long i = w->begin; i < w->end; i++)
+	{
+		int v = w->items[i];
+		long long dv = __atomic_load_n( &w->dist[v], __ATOMIC_RELAXED);
+
+		for (long e = graph->offset[v]; e < graph->offset[v + 1]; e++)
+		{
+			long long weight = WEIGHT( graph, e);
+			if ((weight <= w->delta) != w->light) continue;
+
+			if (_atomic_min( &w->dist[graph->adj[e]], dv + weight))
+				if (!_push( &w->out, graph->adj[e])) w->error = 1;
+		}
+	}
+	return NULL;
+}
+
+// relaxes light or heavy edges of items[0 .. count-1] and puts lowered vertices into their buckets
+// return	1 success
+//			0 overflow
+static int _relax( GRAPH *graph, long long *dist, int *items, long count, int light, long long delta,
+	int num_thread, IVEC *buckets, long num_bucket)
+{
+	SP_WORKER workers[MAX_THREAD];
+	pthread_t tid[MAX_THREAD];
+	int t, started = 0, ok = 1;
+
+	if (count < PARALLEL_CUT) num_thread = 1;
+
+	for (t = 0; t < num_thread; t++)
+	{
+		workers[t].graph = graph;
+		workers[t].dist = dist;
+		workers[t].items = items;
+		workers[t].begin = count * t / num_thread;
+		workers[t].end = count * (t + 1) / num_thread;
+		workers[t].light = light;
+		workers[t].delta = delta;
+		workers[t].out.data = NULL;
+		workers[t].out.len = workers[t].out.capacity = 0;
+		workers[t].error = 0;
+	}
+
+	for (t = 1; t < num_thread; t++)
+	{
+		if (pthread_create( &tid[t], NULL, _relax_thread, &workers[t]) != 0) break;
+		started = t;
+	}
+	_relax_thread( &workers[0]);
+	for (t = started + 1; t < num_thread; t++) _relax_thread( &workers[t]);
+	for (t = 1; t <= started; t++) pthread_join( tid[t], NULL);
+
+	// a vertex lowered several times is put in a bucket by its final dist
+	for (t = 0; t < num_thread; t++)
+	{
+		for (long i = 0; i < workers[t].out.len; i++)
+		{
+			int u = workers[t].out.data[i];
+			if (!_push( &buckets[(dist[u] / delta) % num_bucket], u)) ok = 0;
+		}
+		if (workers[t].error) ok = 0;
+		free( workers[t].out.data);
+	}
+	return ok;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long *sp_Dijkstra( GRAPH *graph, int source)
+{
+	long long *dist = _init_dist( graph, source);
+	INDEX_HEAP h;
+
+	if (!dist) return NULL;
+
+	h.heap = (int *)malloc( (graph->num_vertex + 1) * sizeof(int));
+	h.pos = (int *)malloc( (graph->num_vertex + 1) * sizeof(int));
+	h.key = dist;
+	h.size = 0;
+	if (!h.heap || !h.pos)
+	{
+		free( h.heap);
+		free( h.pos);
+		free( dist);
+		return NULL;
+	}
+	for (int v = 0; v <= graph->num_vertex; v++) h.pos[v] = -1;
+
+	dist[source] = 0;
+	_decrease( &h, source);
+
+	while (h.size > 0)
+	{
+		int v = _extract( &h);
+
+		for (long e = graph->offset[v]; e < graph->offset[v + 1]; e++)
+		{
+			int u = graph->adj[e];
+			long long nd = dist[v] + WEIGHT( graph, e);
+			if (nd < dist[u])
+			{
+				dist[u] = nd;
+				_decrease( &h, u);
+			}
+		}
+	}
+
+	free( h.heap);
+	free( h.pos);
+	return dist;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long *sp_DijkstraRadix( GRAPH *graph, int source)
+{
+	long long *dist = _init_dist( graph, source);
+	RADIX_HEAP h = {0};
+	int ok = 1;
+
+	if (!dist) return NULL;
+
+	dist[source] = 0;
+	ok = _radix_push( &h, 0, source);
+
+	while (ok && h.size > 0)
+	{
+		unsigned long long key;
+		int v = _radix_pop( &h, &key);
+
+		if (v < 0)
+		{
+			ok = 0;
+			break;
+		}
+		if ((long long)key != dist[v]) continue; // stale entry
+
+		for (long e = graph->offset[v]; e < graph->offset[v + 1]; e++)
+		{
+			int u = graph->adj[e];
+			long long nd = dist[v] + WEIGHT( graph, e);
+			if (nd < dist[u])
+			{
+				dist[u] = nd;
+				if (!_radix_push( &h, nd, u)) ok = 0;
+			}
+		}
+	}
+
+	for (int i = 0; i < RADIX_BUCKET; i++) free( h.bucket[i].data);
+	if (!ok)
+	{
+		free( dist);
+		return NULL;
+	}
+	return dist;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// for adt_heap (max heap) : the smaller dist is the larger entry
+static int _compare_entry( const void *p1, const void *p2)
+{
+	const SP_ENTRY *e1 = (const SP_ENTRY *)p1;
+	const SP_ENTRY *e2 = (const SP_ENTRY *)p2;
+
+	return (e1->dist < e2->dist) - (e1->dist > e2->dist);
+}
+
+// entries live in a pool, nothing to free per entry
+static void _keep_entry( void *p)
+{
+	(void)p;
+}
+
+long long *sp_DijkstraHeap( GRAPH *graph, int source)
+{
+	long long *dist = _init_dist( graph, source);
+	HEAP *heap;
+	SP_ENTRY *pool;
+	long used = 0;
+	void *ptr;
+
+	if (!dist) return NULL;
+
+	// at most one entry per edge relaxation plus the source
+	pool = (SP_ENTRY *)malloc( (graph->num_edge + 1) * sizeof(SP_ENTRY));
+	heap = heap_Create( _compare_entry);
+	if (!pool || !heap)
+	{
+		free( pool);
+		if (heap) heap_Destroy( heap, _keep_entry);
+		free( dist);
+		return NULL;
+	}
+
+	dist[source] = 0;
+	pool[used].dist = 0;
+	pool[used].vertex = source;
+	heap_Insert( heap, &pool[used++]);
+
+	while (heap_Delete( heap, &ptr))
+	{
+		SP_ENTRY *entry = (SP_ENTRY *)ptr;
+		int v = entry->vertex;
+
+		if (entry->dist != dist[v]) continue; // stale entry
+
+		for (long e = graph->offset[v]; e < graph->offset[v + 1]; e++)
+		{
+			int u = graph->adj[e];
+			long long nd = dist[v] + WEIGHT( graph, e);
+			if (nd < dist[u])
+			{
+				dist[u] = nd;
+				pool[used].dist = nd;
+				pool[used].vertex = u;
+				if (!heap_Insert( heap, &pool[used++]))
+				{
+					heap_Destroy( heap, _keep_entry);
+					free( pool);
+					free( dist);
+					return NULL;
+				}
+			}
+		}
+	}
+
+	heap_Destroy( heap, _keep_entry);
+	free( pool);
+	return dist;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+long long *sp_DeltaStepping( GRAPH *graph, int source, long long delta, int num_thread)
+{
+	long long *dist = _init_dist( graph, source);
+	long long *relaxed; // dist with which the light edges of v were last relaxed
+	long *settled; // bucket round + 1 in which v was added to the settled list
+	IVEC *buckets, frontier = {0}, done = {0};
+	long long max_weight = 1;
+	long num_bucket, round, empty = 0;
+	int ok = 1;
+
+	if (!dist) return NULL;
+	if (num_thread < 1) num_thread = 1;
+	if (num_thread > MAX_THREAD) num_thread = MAX_THREAD;
+
+	if (graph->weight)
+	{
+		long long sum = 0;
+		for (long e = 0; e < graph->num_edge; e++)
+		{
+			sum += graph->weight[e];
+			if (graph->weight[e] > max_weight) max_weight = graph->weight[e];
+		}
+		if (delta <= 0 && graph->num_edge > 0) delta = sum / graph->num_edge;
+	}
+	if (delta <= 0) delta = 1;
+
+	// a lowered dist is less than max_weight beyond the current bucket, so buckets are reused cyclically
+	num_bucket = max_weight / delta + 2;
+	buckets = (IVEC *)calloc( num_bucket, sizeof(IVEC));
+	relaxed = (long long *)malloc( (graph->num_vertex + 1) * sizeof(long long));
+	settled = (long *)calloc( graph->num_vertex + 1, sizeof(long));
+	if (!buckets || !relaxed || !settled)
+	{
+		free( buckets);
+		free( relaxed);
+		free( settled);
+		free( dist);
+		return NULL;
+	}
+	for (int v = 0; v <= graph->num_vertex; v++) relaxed[v] = -1;
+
+	dist[source] = 0;
+	ok = _push( &buckets[0], source);
+
+	for (round = 0; ok && empty < num_bucket; round++)
+	{
+		IVEC *bucket = &buckets[round % num_bucket];
+
+		if (bucket->len == 0)
+		{
+			empty++;
+			continue;
+		}
+		empty = 0;
+		done.len = 0;
+
+		// light edges may put vertices back into the same bucket
+		while (ok && bucket->len > 0)
+		{
+			frontier.len = 0;
+			for (long i = 0; i < bucket->len; i++)
+			{
+				int v = bucket->data[i];
+
+				// stale entries (moved to a smaller bucket) and duplicates are skipped
+				if (dist[v] / delta != round || relaxed[v] == dist[v]) continue;
+				relaxed[v] = dist[v];
+				if (!_push( &frontier, v)) ok = 0;
+
+				if (settled[v] != round + 1)
+				{
+					settled[v] = round + 1;
+					if (!_push( &done, v)) ok = 0;
+				}
+			}
+			bucket->len = 0;
+
+			if (ok) ok = _relax( graph, dist, frontier.data, frontier.len, 1, delta, num_thread, buckets, num_bucket);
+		}
+
+		// heavy edges can only reach later buckets
+		if (ok) ok = _relax( graph, dist, done.data, done.len, 0, delta, num_thread, buckets, num_bucket);
+	}
+
+	for (long i = 0; i < num_bucket; i++) free( buckets[i].data);
+	free( buckets);
+	free( frontier.data);
+	free( done.data);
+	free( relaxed);
+	free( settled);
+
+	if (!ok)
+	{
+		free( dist);
+		return NULL;
+	}
+	return dist;
+}
@@ -0,0 +1,30 @@
+////////////////////////////////////////////////////////////////////////////////
+// single source shortest paths
+// weights must be non-negative (an unweighted graph uses weight 1)
+// every function returns dist array (num_vertex + 1 entries), dist[v] is SP_INFINITY if v is unreachable
+// NULL is returned for overflow or a negative weight
+
+#define SP_INFINITY	0x7fffffffffffffffLL
+
+////////////////////////////////////////////////////////////////////////////////
+// function declarations
+
+/* Dijkstra on an indexed binary heap (decrease-key in place)
+*/
+long long *sp_Dijkstra( GRAPH *graph, int source);
+
+/* Dijkstra on a radix heap (integer keys, monotone extraction)
+*/
+long long *sp_DijkstraRadix( GRAPH *graph, int source);
+
+/* Dijkstra on adt_heap (binary heap of pointers, a new entry per relaxation, stale entries skipped)
+	baseline for the heaps above
+*/
+long long *sp_DijkstraHeap( GRAPH *graph, int source);
+
+/* delta-stepping
+	vertices are kept in buckets of width delta, light edges (weight <= delta) of a bucket
+	are relaxed by num_thread threads until the bucket is settled, then its heavy edges
+	delta	bucket width, 0 for the average edge weight
+*/
+long long *sp_DeltaStepping( GRAPH *graph, int source, long long delta, int num_thread);